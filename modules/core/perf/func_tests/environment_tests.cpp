@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "core/perf/func_tests/test_task.hpp"
+#include "core/perf/include/environment.hpp"
+#include "core/perf/include/perf.hpp"
+#include "core/task/include/task.hpp"
+
+TEST(environment_tests, check_capture_environment) {
+  const auto snapshot = ppc::core::CaptureEnvironment();
+  EXPECT_GT(snapshot.online_cpus, 0);
+#ifdef __linux__
+  EXPECT_GE(snapshot.load_average, 0.0);
+#endif
+  const std::string line = snapshot.ToString();
+  EXPECT_EQ(line.find("governor="), 0U);
+  EXPECT_NE(line.find(" pinned=-1"), std::string::npos);
+}
+
+TEST(environment_tests, check_noise_warnings) {
+  ppc::core::EnvironmentSnapshot snapshot;
+  snapshot.governor = "powersave";
+  snapshot.turbo = 1;
+  snapshot.smt = 1;
+  snapshot.load_average = 7.0;
+  snapshot.online_cpus = 8;
+
+  ppc::core::NoiseLimits limits;
+  EXPECT_EQ(ppc::core::NoiseWarnings(snapshot, limits).size(), 3U);
+  limits.require_smt_off = true;
+  EXPECT_EQ(ppc::core::NoiseWarnings(snapshot, limits).size(), 4U);
+
+  // unknown fields are never reported
+  EXPECT_TRUE(ppc::core::NoiseWarnings(ppc::core::EnvironmentSnapshot{}, limits).empty());
+}
+
+TEST(environment_tests, check_thread_pin) {
+#ifdef __linux__
+  {
+    ppc::core::ScopedThreadPin pin(0);
+    EXPECT_EQ(sched_getcpu(), 0);
+  }
+  EXPECT_THROW(ppc::core::ScopedThreadPin(-1), std::runtime_error);
+#else
+  GTEST_SKIP();
+#endif
+}
+
+TEST(environment_tests, check_perf_refuses_noisy_environment) {
+  // Create data
+  std::vector<uint32_t> in(200, 1);
+  std::vector<uint32_t> out(1, 0);
+
+  // Create task_data
+  auto task_data = std::make_shared<ppc::core::TaskData>();
+  task_data->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  task_data->inputs_count.emplace_back(in.size());
+  task_data->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  task_data->outputs_count.emplace_back(out.size());
+
+  // Create Perf attributes: any load is too much
+  auto perf_attr = std::make_shared<ppc::core::PerfAttr>();
+  perf_attr->num_running = 3;
+  perf_attr->pin_cpu = 0;
+  perf_attr->noise_policy = ppc::core::PerfAttr::NoisePolicy::kRefuse;
+  perf_attr->noise_limits.max_load_per_cpu = -1.0;
+
+  auto perf_results = std::make_shared<ppc::core::PerfResults>();
+  ppc::core::Perf perf_analyzer(std::make_shared<ppc::test::perf::TestTask<uint32_t>>(task_data));
+#ifdef __linux__
+  EXPECT_THROW(perf_analyzer.PipelineRun(perf_attr, perf_results), std::runtime_error);
+#endif
+
+  // The environment is still recorded when noise is ignored
+  perf_attr->noise_policy = ppc::core::PerfAttr::NoisePolicy::kIgnore;
+  perf_analyzer.PipelineRun(perf_attr, perf_results);
+  EXPECT_EQ(perf_results->environment.pinned_cpu, 0);
+  EXPECT_GT(perf_results->environment.online_cpus, 0);
+}
@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "core/perf/func_tests/test_task.hpp"
+#include "core/perf/include/latency_histogram.hpp"
+#include "core/perf/include/open_loop.hpp"
+#include "core/task/include/task.hpp"
+
+namespace {
+
+constexpr int kWorkers = 2;
+
+// Input and output buffers of one task copy per worker
+struct TaskCopies {
+  std::vector<std::vector<uint32_t>> in{kWorkers, std::vector<uint32_t>(2000, 1)};
+  std::vector<std::vector<uint32_t>> out{kWorkers, std::vector<uint32_t>(1, 0)};
+
+  ppc::core::TaskFactory Factory() {
+    return [this](int copy) {
+      auto task_data = std::make_shared<ppc::core::TaskData>();
+      task_data->inputs.emplace_back(reinterpret_cast<uint8_t *>(in[copy].data()));
+      task_data->inputs_count.emplace_back(in[copy].size());
+      task_data->outputs.emplace_back(reinterpret_cast<uint8_t *>(out[copy].data()));
+      task_data->outputs_count.emplace_back(out[copy].size());
+      return std::make_shared<ppc::test::perf::TestTask<uint32_t>>(task_data);
+    };
+  }
+};
+
+}  // namespace
+
+TEST(open_loop_tests, check_histogram_exact_small_values) {
+  ppc::core::LatencyHistogram histogram;
+  for (int64_t value = 1; value <= 50; value++) {
+    histogram.Record(value);
+  }
+  EXPECT_EQ(histogram.Count(), 50U);
+  EXPECT_EQ(histogram.Min(), 1);
+  EXPECT_EQ(histogram.Max(), 50);
+  EXPECT_EQ(histogram.Percentile(0.5), 25);
+  EXPECT_EQ(histogram.Percentile(1.0), 50);
+  EXPECT_DOUBLE_EQ(histogram.Mean(), 25.5);
+}
+
+TEST(open_loop_tests, check_histogram_relative_error) {
+  ppc::core::LatencyHistogram histogram;
+  for (int64_t value = 1000; value <= 1000000; value += 1000) {
+    histogram.Record(value);
+  }
+  const double tolerance = 1.0 / ppc::core::LatencyHistogram::kSubBuckets;
+  EXPECT_NEAR(static_cast<double>(histogram.Percentile(0.5)), 500000.0, 500000.0 * tolerance);
+  EXPECT_NEAR(static_cast<double>(histogram.Percentile(0.99)), 990000.0, 990000.0 * tolerance);
+  EXPECT_NEAR(static_cast<double>(histogram.Percentile(0.999)), 999000.0, 999000.0 * tolerance);
+  EXPECT_EQ(histogram.Max(), 1000000);
+}
+
+TEST(open_loop_tests, check_histogram_merge_and_clear) {
+  ppc::core::LatencyHistogram a;
+  ppc::core::LatencyHistogram b;
+  a.Record(10);
+  b.Record(int64_t{1} << 40);
+  a.Merge(b);
+  EXPECT_EQ(a.Count(), 2U);
+  EXPECT_EQ(a.Min(), 10);
+  EXPECT_EQ(a.Max(), int64_t{1} << 40);
+  EXPECT_THROW(a.Record(-1), std::invalid_argument);
+  a.Clear();
+  EXPECT_EQ(a.Count(), 0U);
+  EXPECT_EQ(a.Percentile(0.99), 0);
+}
+
+TEST(open_loop_tests, check_constant_rate_load) {
+  TaskCopies copies;
+  ppc::core::LoadAttr attr;
+  attr.arrival = ppc::core::LoadAttr::kConstant;
+  attr.rate_per_sec = 2000.0;
+  attr.num_requests = 200;
+  attr.num_workers = kWorkers;
+  const auto results = ppc::core::RunOpenLoad(copies.Factory(), attr);
+
+  EXPECT_EQ(results.latency_ns.Count(), attr.num_requests);
+  EXPECT_NEAR(results.offered_rate, attr.rate_per_sec, 1e-6);
+  EXPECT_GT(results.achieved_rate, 0.0);
+  EXPECT_LE(results.latency_ns.Percentile(0.5), results.latency_ns.Percentile(0.99));
+  EXPECT_LE(results.latency_ns.Percentile(0.99), results.latency_ns.Max());
+  for (const auto &out : copies.out) {
+    EXPECT_EQ(out[0], copies.in[0].size());
+  }
+}
+
+TEST(open_loop_tests, check_max_sustainable_rate) {
+  TaskCopies copies;
+  ppc::core::SustainableRateAttr attr;
+  attr.load.num_requests = 200;
+  attr.load.num_workers = kWorkers;
+  attr.steps = 4;
+  const auto results = ppc::core::FindMaxSustainableRate(copies.Factory(), attr);
+
+  ASSERT_EQ(results.probes.size(), 5U);
+  EXPECT_GT(results.max_rate, 0.0);
+  EXPECT_GT(results.latency_limit_sec, 0.0);
+  for (const auto &probe : results.probes) {
+    EXPECT_EQ(probe.latency_ns.Count(), attr.load.num_requests);
+  }
+  ppc::core::PrintSustainableRate("core/perf", results);
+}
+
+TEST(open_loop_tests, check_invalid_rate_throws) {
+  TaskCopies copies;
+  ppc::core::LoadAttr attr;
+  attr.rate_per_sec = 0.0;
+  attr.num_workers = kWorkers;
+  EXPECT_THROW(ppc::core::RunOpenLoad(copies.Factory(), attr), std::invalid_argument);
+}
@@ -0,0 +1,46 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <vector>
+
+#include "core/perf/include/overhead.hpp"
+
+TEST(overhead_tests, check_thread_sweep) {
+  std::vector<int> built_for;
+  std::atomic<uint64_t> calls = 0;
+  auto factory = [&](int num_threads) -> std::function<void()> {
+    built_for.push_back(num_threads);
+    return [&] { calls.fetch_add(1, std::memory_order_relaxed); };
+  };
+
+  ppc::core::OverheadAttr attr;
+  attr.ops_per_batch = 100;
+  attr.batches = 3;
+  attr.max_threads = 6;
+  const auto points = ppc::core::MeasureOverhead(factory, attr);
+
+  const std::vector<int> expected_sweep = {1, 2, 4, 6};
+  EXPECT_EQ(built_for, expected_sweep);
+  ASSERT_EQ(points.size(), expected_sweep.size());
+  for (size_t i = 0; i < points.size(); i++) {
+    EXPECT_EQ(points[i].threads, expected_sweep[i]);
+    EXPECT_LE(points[i].min_ns_per_op, points[i].ns_per_op);
+    EXPECT_LE(points[i].ns_per_op, points[i].max_ns_per_op);
+  }
+  // one warm-up batch and the timed ones for every thread count
+  EXPECT_EQ(calls.load(), expected_sweep.size() * (attr.batches + 1) * attr.ops_per_batch);
+}
+
+TEST(overhead_tests, check_invalid_attr_throws) {
+  auto factory = [](int) -> std::function<void()> { return [] {}; };
+  ppc::core::OverheadAttr attr;
+  attr.ops_per_batch = 0;
+  EXPECT_THROW(ppc::core::MeasureOverhead(factory, attr), std::invalid_argument);
+  attr.ops_per_batch = 1;
+  attr.batches = 0;
+  EXPECT_THROW(ppc::core::MeasureOverhead(factory, attr), std::invalid_argument);
+}
@@ -2,12 +2,22 @@
 
 #include <chrono>
 #include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
 #include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
 #include <vector>
 
 #include "core/perf/func_tests/test_task.hpp"
 #include "core/perf/include/perf.hpp"
+#include "core/perf/include/roofline.hpp"
 #include "core/task/include/task.hpp"
+#include "core/trace/include/load_balance.hpp"
+#include "core/trace/include/trace.hpp"
+#include "core/util/include/util.hpp"
 
 TEST(perf_tests, check_perf_pipeline) {
   // Create data
@@ -175,3 +185,425 @@ TEST(perf_tests, check_perf_task_float) {
   ASSERT_LE(perf_results->time_sec, ppc::core::PerfResults::kMaxTime);
   EXPECT_EQ(out[0], in.size());
 }
+
+TEST(perf_tests, check_perf_pipeline_trace) {
+  // Create data
+  std::vector<uint32_t> in(2000, 1);
+  std::vector<uint32_t> out(1, 0);
+
+  // Create task_data
+  auto task_data = std::make_shared<ppc::core::TaskData>();
+  task_data->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  task_data->inputs_count.emplace_back(in.size());
+  task_data->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  task_data->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  auto test_task = std::make_shared<ppc::test::perf::TestTask<uint32_t>>(task_data);
+
+  // Create Perf attributes
+  auto perf_attr = std::make_shared<ppc::core::PerfAttr>();
+  perf_attr->num_running = 3;
+  perf_attr->trace_path = (std::filesystem::temp_directory_path() / "ppc_perf_trace.json").string();
+
+  // Create and init perf results
+  auto perf_results = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  ppc::core::Perf perf_analyzer(test_task);
+  perf_analyzer.PipelineRun(perf_attr, perf_results);
+
+  std::ifstream trace_file(perf_attr->trace_path);
+  ASSERT_TRUE(trace_file.is_open());
+  std::stringstream trace;
+  trace << trace_file.rdbuf();
+  trace_file.close();
+  std::filesystem::remove(perf_attr->trace_path);
+
+  EXPECT_NE(trace.str().find("\"name\":\"iteration\""), std::string::npos);
+  EXPECT_NE(trace.str().find("\"name\":\"PostProcessing\""), std::string::npos);
+  EXPECT_EQ(out[0], in.size());
+}
+
+TEST(perf_tests, check_perf_disables_instrumentation_on_exception) {
+  // Create data
+  std::vector<uint32_t> in(16, 1);
+  std::vector<uint32_t> out(1, 0);
+
+  // Create task_data
+  auto task_data = std::make_shared<ppc::core::TaskData>();
+  task_data->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  task_data->inputs_count.emplace_back(in.size());
+  task_data->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  task_data->outputs_count.emplace_back(out.size());
+
+  // Create Perf attributes
+  auto perf_attr = std::make_shared<ppc::core::PerfAttr>();
+  perf_attr->num_running = 3;
+  perf_attr->trace_path = (std::filesystem::temp_directory_path() / "ppc_perf_trace_throw.json").string();
+  perf_attr->load_balance = true;
+
+  // Create and init perf results
+  auto perf_results = std::make_shared<ppc::core::PerfResults>();
+
+  // A failing run leaves tracing and the load balance accounting off
+  ppc::core::Perf perf_analyzer(std::make_shared<ppc::test::perf::ThrowingTask<uint32_t>>(task_data));
+  EXPECT_THROW(perf_analyzer.TaskRun(perf_attr, perf_results), std::runtime_error);
+  EXPECT_FALSE(ppc::core::Trace::IsEnabled());
+  EXPECT_FALSE(ppc::core::LoadBalance::IsEnabled());
+}
+
+TEST(perf_tests, check_perf_task_warm_and_cold) {
+  // Create data
+  std::vector<uint32_t> in(20000, 1);
+  std::vector<uint32_t> out(1, 0);
+
+  // Create task_data
+  auto task_data = std::make_shared<ppc::core::TaskData>();
+  task_data->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  task_data->inputs_count.emplace_back(in.size());
+  task_data->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  task_data->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  auto test_task = std::make_shared<ppc::test::perf::TestTask<uint32_t>>(task_data);
+
+  // Create Perf attributes
+  auto perf_attr = std::make_shared<ppc::core::PerfAttr>();
+  perf_attr->num_running = 5;
+  perf_attr->cache_mode = ppc::core::PerfAttr::kWarmAndCold;
+  perf_attr->cache_flush_bytes = 1 << 20;
+  const auto t0 = std::chrono::high_resolution_clock::now();
+  perf_attr->current_timer = [&] {
+    auto current_time_point = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(current_time_point - t0).count();
+    return static_cast<double>(duration) * 1e-9;
+  };
+
+  // Create and init perf results
+  auto perf_results = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  ppc::core::Perf perf_analyzer(test_task);
+  perf_analyzer.TaskRun(perf_attr, perf_results);
+
+  // Get perf statistic
+  ppc::core::Perf::PrintPerfStatistic(perf_results);
+  EXPECT_GT(perf_results->time_sec, 0.0);
+  EXPECT_GT(perf_results->cold_time_sec, 0.0);
+  EXPECT_EQ(out[0], in.size());
+}
+
+TEST(perf_tests, check_perf_pipeline_cold_relocated_inputs) {
+  // Create data
+  std::vector<uint32_t> in(2000, 1);
+  std::vector<uint32_t> out(1, 0);
+
+  // Create task_data
+  auto task_data = std::make_shared<ppc::core::TaskData>();
+  task_data->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  task_data->inputs_count.emplace_back(in.size());
+  task_data->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  task_data->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  auto test_task = std::make_shared<ppc::test::perf::TestTask<uint32_t>>(task_data);
+
+  // Create Perf attributes
+  auto perf_attr = std::make_shared<ppc::core::PerfAttr>();
+  perf_attr->num_running = 5;
+  perf_attr->cache_mode = ppc::core::PerfAttr::kCold;
+  perf_attr->cache_flush_bytes = 1 << 20;
+  perf_attr->input_bytes = {in.size() * sizeof(uint32_t)};
+
+  // Create and init perf results
+  auto perf_results = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  ppc::core::Perf perf_analyzer(test_task);
+  perf_analyzer.PipelineRun(perf_attr, perf_results);
+
+  EXPECT_EQ(task_data->inputs[0], reinterpret_cast<uint8_t *>(in.data()));
+  EXPECT_EQ(out[0], in.size());
+}
+
+TEST(perf_tests, check_perf_task_cold_keeps_inputs) {
+  // Create data
+  std::vector<uint32_t> in(2000, 1);
+  std::vector<uint32_t> out(1, 0);
+
+  // Create task_data
+  auto task_data = std::make_shared<ppc::core::TaskData>();
+  task_data->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  task_data->inputs_count.emplace_back(in.size());
+  task_data->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  task_data->outputs_count.emplace_back(out.size());
+
+  // Create Perf attributes
+  auto perf_attr = std::make_shared<ppc::core::PerfAttr>();
+  perf_attr->num_running = 5;
+  perf_attr->cache_mode = ppc::core::PerfAttr::kCold;
+  perf_attr->cache_flush_bytes = 1 << 20;
+  // more entries than inputs: TaskRun ignores input_bytes, PipelineRun would throw
+  perf_attr->input_bytes = {in.size() * sizeof(uint32_t), 0};
+
+  // Create and init perf results
+  auto perf_results = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  ppc::core::Perf perf_analyzer(std::make_shared<ppc::test::perf::TestTask<uint32_t>>(task_data));
+  EXPECT_NO_THROW(perf_analyzer.TaskRun(perf_attr, perf_results));
+  EXPECT_GT(perf_results->cold_time_sec, 0.0);
+  EXPECT_EQ(out[0], in.size());
+}
+
+TEST(perf_tests, check_perf_roofline_from_cache) {
+#ifndef _WIN32
+  const auto cache_dir = std::filesystem::temp_directory_path() / "ppc_roofline_tests";
+  std::filesystem::create_directories(cache_dir);
+  setenv("PPC_PERF_CACHE_DIR", cache_dir.string().c_str(), 1);  // NOLINT(misc-include-cleaner)
+  std::ofstream(ppc::core::GetMachinePeaksCachePath()) << ppc::util::GetPPCNumThreads() << " 20.5 100.25\n";
+
+  // Create data
+  std::vector<float> in(20000, 1);
+  std::vector<float> out(1, 0);
+
+  // Create task_data
+  auto task_data = std::make_shared<ppc::core::TaskData>();
+  task_data->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  task_data->inputs_count.emplace_back(in.size());
+  task_data->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  task_data->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  auto test_task = std::make_shared<ppc::test::perf::TestTask<float>>(task_data);
+
+  // Create Perf attributes
+  auto perf_attr = std::make_shared<ppc::core::PerfAttr>();
+  perf_attr->num_running = 10;
+  perf_attr->roofline = true;
+  const auto t0 = std::chrono::high_resolution_clock::now();
+  perf_attr->current_timer = [&] {
+    auto current_time_point = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(current_time_point - t0).count();
+    return static_cast<double>(duration) * 1e-9;
+  };
+
+  // Create and init perf results
+  auto perf_results = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  ppc::core::Perf perf_analyzer(test_task);
+  perf_analyzer.TaskRun(perf_attr, perf_results);
+  const auto cout_flags = std::cout.flags();
+  const auto cout_precision = std::cout.precision();
+  ppc::core::Perf::PrintPerfStatistic(perf_results);
+  // the formatting of the report does not leak into later output
+  EXPECT_EQ(std::cout.flags(), cout_flags);
+  EXPECT_EQ(std::cout.precision(), cout_precision);
+
+  unsetenv("PPC_PERF_CACHE_DIR");  // NOLINT(misc-include-cleaner)
+  std::filesystem::remove_all(cache_dir);
+
+  EXPECT_DOUBLE_EQ(perf_results->peak_bandwidth_gbs, 20.5);
+  EXPECT_DOUBLE_EQ(perf_results->peak_gflops, 100.25);
+  EXPECT_GT(perf_results->gflops, 0.0);
+  EXPECT_DOUBLE_EQ(perf_results->bandwidth_gbs, perf_results->gflops * sizeof(float));
+  EXPECT_EQ(out[0], in.size());
+#else
+  GTEST_SKIP();
+#endif
+}
+
+TEST(perf_tests, check_perf_pipeline_stages_with_sync_start) {
+  // Create data
+  std::vector<uint32_t> in(20000, 1);
+  std::vector<uint32_t> out(1, 0);
+
+  // Create task_data
+  auto task_data = std::make_shared<ppc::core::TaskData>();
+  task_data->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  task_data->inputs_count.emplace_back(in.size());
+  task_data->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  task_data->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  auto test_task = std::make_shared<ppc::test::perf::TestTask<uint32_t>>(task_data);
+
+  // Create Perf attributes
+  auto perf_attr = std::make_shared<ppc::core::PerfAttr>();
+  perf_attr->num_running = 7;
+  const auto t0 = std::chrono::high_resolution_clock::now();
+  perf_attr->current_timer = [&] {
+    auto current_time_point = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(current_time_point - t0).count();
+    return static_cast<double>(duration) * 1e-9;
+  };
+  uint64_t sync_count = 0;
+  perf_attr->sync_start = [&] { sync_count++; };
+
+  // Create and init perf results
+  auto perf_results = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  ppc::core::Perf perf_analyzer(test_task);
+  perf_analyzer.PipelineRun(perf_attr, perf_results);
+
+  double stages_sum = 0.0;
+  for (double stage_time : perf_results->stage_time_sec) {
+    stages_sum += stage_time;
+  }
+  EXPECT_EQ(sync_count, perf_attr->num_running);
+  EXPECT_GT(perf_results->stage_time_sec[ppc::core::PerfResults::kRun], 0.0);
+  EXPECT_LE(stages_sum, perf_results->time_sec);
+  EXPECT_EQ(out[0], in.size());
+}
+
+TEST(perf_tests, check_perf_pipeline_rates_from_warm_run_stage) {
+  // Create data
+  std::vector<uint32_t> in(2000, 1);
+  std::vector<uint32_t> out(1, 0);
+
+  // Create task_data
+  auto task_data = std::make_shared<ppc::core::TaskData>();
+  task_data->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  task_data->inputs_count.emplace_back(in.size());
+  task_data->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  task_data->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  auto test_task = std::make_shared<ppc::test::perf::TestTask<uint32_t>>(task_data);
+
+  // Create Perf attributes: every reading of the clock advances it by one second
+  auto perf_attr = std::make_shared<ppc::core::PerfAttr>();
+  perf_attr->num_running = 4;
+  perf_attr->cache_mode = ppc::core::PerfAttr::kWarmAndCold;
+  perf_attr->cache_flush_bytes = 1 << 16;
+  double ticks = 0.0;
+  perf_attr->current_timer = [&] { return ticks += 1.0; };
+
+  // Create and init perf results
+  auto perf_results = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  ppc::core::Perf perf_analyzer(test_task);
+  perf_analyzer.PipelineRun(perf_attr, perf_results);
+
+  // the stages cover the warm loop only, one tick per stage and run
+  const auto runs = static_cast<double>(perf_attr->num_running);
+  for (double stage_time : perf_results->stage_time_sec) {
+    EXPECT_DOUBLE_EQ(stage_time, runs);
+  }
+  EXPECT_GT(perf_results->time_sec, 4.0 * runs);
+  // the rates exclude Validation, PreProcessing and PostProcessing
+  EXPECT_DOUBLE_EQ(perf_results->gflops, static_cast<double>(in.size()) * 1e-9);
+  EXPECT_EQ(out[0], in.size());
+}
+
+TEST(perf_tests, check_perf_task_run_samples) {
+  // Create data
+  std::vector<uint32_t> in(2000, 1);
+  std::vector<uint32_t> out(1, 0);
+
+  // Create task_data
+  auto task_data = std::make_shared<ppc::core::TaskData>();
+  task_data->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  task_data->inputs_count.emplace_back(in.size());
+  task_data->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  task_data->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  auto test_task = std::make_shared<ppc::test::perf::TestTask<uint32_t>>(task_data);
+
+  // Create Perf attributes
+  auto perf_attr = std::make_shared<ppc::core::PerfAttr>();
+  perf_attr->num_running = 6;
+  const auto t0 = std::chrono::high_resolution_clock::now();
+  perf_attr->current_timer = [&] {
+    auto current_time_point = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(current_time_point - t0).count();
+    return static_cast<double>(duration) * 1e-9;
+  };
+
+  // Create and init perf results
+  auto perf_results = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  ppc::core::Perf perf_analyzer(test_task);
+  perf_analyzer.TaskRun(perf_attr, perf_results);
+
+  ASSERT_EQ(perf_results->run_time_sec.size(), perf_attr->num_running);
+  double samples_sum = 0.0;
+  for (double sample : perf_results->run_time_sec) {
+    EXPECT_GE(sample, 0.0);
+    samples_sum += sample;
+  }
+  EXPECT_LE(samples_sum, perf_results->time_sec);
+  EXPECT_EQ(perf_results->input_size, in.size());
+  EXPECT_EQ(perf_results->num_threads, ppc::util::GetPPCNumThreads());
+}
+
+TEST(perf_tests, check_perf_task_run_verifies_reset_state) {
+  // Create data
+  std::vector<uint32_t> in(2000, 1);
+  std::vector<uint32_t> out(1, 0);
+
+  // Create task_data
+  auto task_data = std::make_shared<ppc::core::TaskData>();
+  task_data->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  task_data->inputs_count.emplace_back(in.size());
+  task_data->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  task_data->outputs_count.emplace_back(out.size());
+
+  // Create Perf attributes
+  auto perf_attr = std::make_shared<ppc::core::PerfAttr>();
+  perf_attr->num_running = 5;
+  perf_attr->verify_runs = true;
+  perf_attr->output_bytes = {out.size() * sizeof(uint32_t)};
+
+  // Create and init perf results
+  auto perf_results = std::make_shared<ppc::core::PerfResults>();
+
+  // The reset task gives the same output after one and after several runs
+  ppc::core::Perf perf_analyzer(std::make_shared<ppc::test::perf::TestTask<uint32_t>>(task_data));
+  EXPECT_NO_THROW(perf_analyzer.TaskRun(perf_attr, perf_results));
+  EXPECT_EQ(out[0], in.size());
+
+  // The accumulating one does not
+  perf_analyzer.SetTask(std::make_shared<ppc::test::perf::NonResettingTask<uint32_t>>(task_data));
+  EXPECT_THROW(perf_analyzer.TaskRun(perf_attr, perf_results), std::runtime_error);
+}
+
+TEST(perf_tests, check_perf_load_balance_summary) {
+  // Create data
+  std::vector<uint32_t> in(2000, 1);
+  std::vector<uint32_t> out(1, 0);
+
+  // Create task_data
+  auto task_data = std::make_shared<ppc::core::TaskData>();
+  task_data->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  task_data->inputs_count.emplace_back(in.size());
+  task_data->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  task_data->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  auto test_task = std::make_shared<ppc::test::perf::BalancedTask<uint32_t>>(task_data);
+
+  // Create Perf attributes
+  auto perf_attr = std::make_shared<ppc::core::PerfAttr>();
+  perf_attr->num_running = 4;
+  perf_attr->load_balance = true;
+
+  // Create and init perf results
+  auto perf_results = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  ppc::core::Perf perf_analyzer(test_task);
+  perf_analyzer.PipelineRun(perf_attr, perf_results);
+
+  EXPECT_EQ(perf_results->load_balance.regions, perf_attr->num_running);
+  EXPECT_GE(perf_results->load_balance.imbalance, 1.0);
+  EXPECT_GE(perf_results->load_balance.worst_imbalance, perf_results->load_balance.imbalance);
+  EXPECT_FALSE(ppc::core::LoadBalance::IsEnabled());
+  EXPECT_EQ(out[0], in.size());
+}
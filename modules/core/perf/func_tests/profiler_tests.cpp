@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/perf/func_tests/test_task.hpp"
+#include "core/perf/include/perf.hpp"
+#include "core/perf/include/profiler.hpp"
+#include "core/task/include/task.hpp"
+
+namespace {
+
+double SpinFor(std::chrono::milliseconds duration) {
+  volatile double sink = 0.0;
+  const auto end = std::chrono::steady_clock::now() + duration;
+  while (std::chrono::steady_clock::now() < end) {
+    sink = sink + 1.0;
+  }
+  return sink;
+}
+
+}  // namespace
+
+TEST(profiler_tests, check_samples_from_threads_in_folded_format) {
+#if defined(__unix__) || defined(__APPLE__)
+  ppc::core::SamplingProfiler::Start(1000);
+  EXPECT_TRUE(ppc::core::SamplingProfiler::IsRunning());
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 2; t++) {
+    threads.emplace_back([] { SpinFor(std::chrono::milliseconds(150)); });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  ppc::core::SamplingProfiler::Stop();
+  EXPECT_FALSE(ppc::core::SamplingProfiler::IsRunning());
+  EXPECT_GT(ppc::core::SamplingProfiler::SampleCount(), 0U);
+
+  std::stringstream folded;
+  ppc::core::SamplingProfiler::WriteFolded(folded);
+  std::string line;
+  size_t total = 0;
+  while (std::getline(folded, line)) {
+    // "frame;frame;... count"
+    const auto space = line.rfind(' ');
+    ASSERT_NE(space, std::string::npos);
+    EXPECT_EQ(line.substr(0, space).find(' '), std::string::npos);
+    total += std::stoull(line.substr(space + 1));
+  }
+  EXPECT_GT(total, 0U);
+  EXPECT_LE(total, ppc::core::SamplingProfiler::SampleCount());
+#else
+  GTEST_SKIP();
+#endif
+}
+
+TEST(profiler_tests, check_one_hz_interval) {
+#if defined(__unix__) || defined(__APPLE__)
+  // a whole-second interval does not fit in tv_usec alone
+  ASSERT_NO_THROW(ppc::core::SamplingProfiler::Start(1));
+  EXPECT_TRUE(ppc::core::SamplingProfiler::IsRunning());
+  ppc::core::SamplingProfiler::Stop();
+  EXPECT_FALSE(ppc::core::SamplingProfiler::IsRunning());
+#else
+  GTEST_SKIP();
+#endif
+}
+
+TEST(profiler_tests, check_perf_writes_profile) {
+#if defined(__unix__) || defined(__APPLE__)
+  // Create data
+  std::vector<uint32_t> in(1 << 20, 1);
+  std::vector<uint32_t> out(1, 0);
+
+  // Create task_data
+  auto task_data = std::make_shared<ppc::core::TaskData>();
+  task_data->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  task_data->inputs_count.emplace_back(in.size());
+  task_data->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  task_data->outputs_count.emplace_back(out.size());
+
+  // Create Perf attributes
+  auto perf_attr = std::make_shared<ppc::core::PerfAttr>();
+  perf_attr->num_running = 100;
+  perf_attr->profile_path = (std::filesystem::temp_directory_path() / "ppc_perf_profile.folded").string();
+
+  auto perf_results = std::make_shared<ppc::core::PerfResults>();
+  ppc::core::Perf perf_analyzer(std::make_shared<ppc::test::perf::TestTask<uint32_t>>(task_data));
+  perf_analyzer.TaskRun(perf_attr, perf_results);
+
+  EXPECT_FALSE(ppc::core::SamplingProfiler::IsRunning());
+  std::ifstream profile(perf_attr->profile_path);
+  ASSERT_TRUE(profile.is_open());
+  std::string line;
+  EXPECT_TRUE(std::getline(profile, line));
+  profile.close();
+  std::filesystem::remove(perf_attr->profile_path);
+#else
+  GTEST_SKIP();
+#endif
+}
+
+TEST(profiler_tests, check_perf_stops_profiler_on_exception) {
+#if defined(__unix__) || defined(__APPLE__)
+  std::vector<uint32_t> in(16, 1);
+  std::vector<uint32_t> out(1, 0);
+
+  auto task_data = std::make_shared<ppc::core::TaskData>();
+  task_data->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  task_data->inputs_count.emplace_back(in.size());
+  task_data->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  task_data->outputs_count.emplace_back(out.size());
+
+  auto perf_attr = std::make_shared<ppc::core::PerfAttr>();
+  perf_attr->num_running = 5;
+  perf_attr->profile_path = (std::filesystem::temp_directory_path() / "ppc_perf_profile_throw.folded").string();
+
+  auto perf_results = std::make_shared<ppc::core::PerfResults>();
+  ppc::core::Perf perf_analyzer(std::make_shared<ppc::test::perf::ThrowingTask<uint32_t>>(task_data));
+  EXPECT_THROW(perf_analyzer.TaskRun(perf_attr, perf_results), std::runtime_error);
+  EXPECT_FALSE(ppc::core::SamplingProfiler::IsRunning());
+#else
+  GTEST_SKIP();
+#endif
+}
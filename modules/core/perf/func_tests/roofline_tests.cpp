@@ -0,0 +1,11 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+
+#include "core/perf/include/roofline.hpp"
+
+TEST(roofline_tests, check_measure_machine_peaks) {
+  const auto peaks = ppc::core::MeasureMachinePeaks(1, size_t{8} << 20);
+  EXPECT_GT(peaks.bandwidth_gbs, 0.0);
+  EXPECT_GT(peaks.gflops, 0.0);
+}
@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "core/perf/func_tests/test_task.hpp"
+#include "core/perf/include/size_sweep.hpp"
+#include "core/task/include/task.hpp"
+
+namespace {
+
+// Vector of n ones summed by the test task
+ppc::core::SizedTask GenerateOnes(uint64_t n) {
+  struct Storage {
+    std::vector<uint32_t> in;
+    std::vector<uint32_t> out;
+  };
+  auto storage = std::make_shared<Storage>();
+  storage->in.assign(n, 1);
+  storage->out.assign(1, 0);
+
+  auto task_data = std::make_shared<ppc::core::TaskData>();
+  task_data->inputs.emplace_back(reinterpret_cast<uint8_t *>(storage->in.data()));
+  task_data->inputs_count.emplace_back(storage->in.size());
+  task_data->outputs.emplace_back(reinterpret_cast<uint8_t *>(storage->out.data()));
+  task_data->outputs_count.emplace_back(storage->out.size());
+  return {.task = std::make_shared<ppc::test::perf::TestTask<uint32_t>>(task_data), .storage = storage};
+}
+
+}  // namespace
+
+TEST(size_sweep_tests, check_geometric_sweep_and_bands) {
+  ppc::core::RegisterInputGenerator("ones", GenerateOnes);
+
+  ppc::core::SizeSweepAttr attr;
+  attr.min_n = 1 << 12;
+  attr.max_n = 1 << 20;
+  attr.factor = 4.0;
+  attr.min_time_sec = 0.01;
+  const auto results = ppc::core::MeasureSizeSweep(ppc::core::GetInputGenerator("ones"), attr);
+
+  ASSERT_EQ(results.points.size(), 5U);
+  for (size_t i = 0; i < results.points.size(); i++) {
+    EXPECT_EQ(results.points[i].n, uint64_t{1} << (12 + (2 * i)));
+    EXPECT_GT(results.points[i].time_sec, 0.0);
+    EXPECT_GT(results.points[i].throughput, 0.0);
+  }
+  ASSERT_FALSE(results.bands.empty());
+  EXPECT_EQ(results.bands.front().first, 0U);
+  EXPECT_EQ(results.bands.back().last, results.points.size() - 1);
+  for (size_t i = 1; i < results.bands.size(); i++) {
+    EXPECT_EQ(results.bands[i].first, results.bands[i - 1].last + 1);
+  }
+  ppc::core::PrintSizeSweep("core/perf", results);
+}
+
+TEST(size_sweep_tests, check_invalid_attributes_throw) {
+  ppc::core::SizeSweepAttr attr;
+  attr.factor = 1.0;
+  EXPECT_THROW(ppc::core::MeasureSizeSweep(GenerateOnes, attr), std::invalid_argument);
+  EXPECT_THROW(ppc::core::GetInputGenerator("unregistered"), std::invalid_argument);
+}
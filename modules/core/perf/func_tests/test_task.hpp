@@ -2,10 +2,12 @@
 
 #include <chrono>
 #include <memory>
+#include <stdexcept>
 #include <thread>
 #include <vector>
 
 #include "core/task/include/task.hpp"
+#include "core/trace/include/load_balance.hpp"
 
 namespace ppc::test::perf {
 
@@ -32,11 +34,70 @@ class TestTask : public ppc::core::Task {
 
   bool PostProcessingImpl() override { return true; }
 
+  void ResetRunState() override { output_[0] = 0; }
+
+  [[nodiscard]] double GetFlopsPerRun() const override { return task_data->inputs_count[0]; }
+  [[nodiscard]] double GetBytesPerRun() const override {
+    return static_cast<double>(task_data->inputs_count[0]) * sizeof(T);
+  }
+
  private:
   T *input_{};
   T *output_{};
 };
 
+// Keeps accumulating over repeated Run() calls
+template <class T>
+class NonResettingTask : public TestTask<T> {
+ public:
+  explicit NonResettingTask(ppc::core::TaskDataPtr perf_task_data) : TestTask<T>(perf_task_data) {}
+
+  void ResetRunState() override {}
+};
+
+// Sums the input in two threads accounted as one parallel region
+template <class T>
+class BalancedTask : public TestTask<T> {
+ public:
+  explicit BalancedTask(ppc::core::TaskDataPtr perf_task_data) : TestTask<T>(perf_task_data) {}
+
+  bool RunImpl() override {
+    constexpr int kWorkers = 2;
+    const T *input = reinterpret_cast<T *>(this->task_data->inputs[0]);
+    const unsigned count = this->task_data->inputs_count[0];
+    std::vector<T> sums(kWorkers, 0);
+    ppc::core::ParallelRegion region("sum", kWorkers);
+    std::vector<std::thread> threads;
+    for (int id = 0; id < kWorkers; id++) {
+      threads.emplace_back([&, id] {
+        const unsigned begin = count * id / kWorkers;
+        const unsigned end = count * (id + 1) / kWorkers;
+        ppc::core::WorkerScope scope(region, id, end - begin);
+        for (unsigned i = begin; i < end; i++) {
+          sums[id] += input[i];
+        }
+      });
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+    auto *output = reinterpret_cast<T *>(this->task_data->outputs[0]);
+    for (const T &sum : sums) {
+      output[0] += sum;
+    }
+    return true;
+  }
+};
+
+// Fails in every Run()
+template <class T>
+class ThrowingTask : public TestTask<T> {
+ public:
+  explicit ThrowingTask(ppc::core::TaskDataPtr perf_task_data) : TestTask<T>(perf_task_data) {}
+
+  bool RunImpl() override { throw std::runtime_error("ThrowingTask"); }
+};
+
 template <class T>
 class FakePerfTask : public TestTask<T> {
  public:
@@ -0,0 +1,53 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "core/perf/func_tests/test_task.hpp"
+#include "core/perf/include/throughput.hpp"
+#include "core/task/include/task.hpp"
+
+TEST(throughput_tests, check_concurrency_sweep) {
+  constexpr int kCopies = 5;
+
+  // Create data of every copy
+  std::vector<std::vector<uint32_t>> in(kCopies, std::vector<uint32_t>(20000, 1));
+  std::vector<std::vector<uint32_t>> out(kCopies, std::vector<uint32_t>(1, 0));
+
+  auto factory = [&](int copy) {
+    auto task_data = std::make_shared<ppc::core::TaskData>();
+    task_data->inputs.emplace_back(reinterpret_cast<uint8_t *>(in[copy].data()));
+    task_data->inputs_count.emplace_back(in[copy].size());
+    task_data->outputs.emplace_back(reinterpret_cast<uint8_t *>(out[copy].data()));
+    task_data->outputs_count.emplace_back(out[copy].size());
+    return std::make_shared<ppc::test::perf::TestTask<uint32_t>>(task_data);
+  };
+
+  ppc::core::ThroughputAttr attr;
+  attr.runs_per_copy = 4;
+  attr.max_concurrency = kCopies;
+  const auto points = ppc::core::MeasureThroughput(factory, attr);
+
+  ASSERT_EQ(points.size(), 4U);
+  const std::vector<int> expected_sweep = {1, 2, 4, 5};
+  for (size_t i = 0; i < points.size(); i++) {
+    EXPECT_EQ(points[i].concurrency, expected_sweep[i]);
+    EXPECT_GT(points[i].tasks_per_sec, 0.0);
+    EXPECT_LE(points[i].latency_p50_sec, points[i].latency_max_sec);
+    EXPECT_GT(points[i].latency_avg_sec, 0.0);
+  }
+  EXPECT_DOUBLE_EQ(points.front().scaling, 1.0);
+  for (int copy = 0; copy < kCopies; copy++) {
+    EXPECT_EQ(out[copy][0], in[copy].size());
+  }
+}
+
+TEST(throughput_tests, check_zero_runs_throws) {
+  ppc::core::ThroughputAttr attr;
+  attr.runs_per_copy = 0;
+  EXPECT_THROW(ppc::core::MeasureThroughput([](int) { return std::shared_ptr<ppc::core::Task>(); }, attr),
+               std::invalid_argument);
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ppc::core {
+
+// State of the machine that affects timing stability, read from /sys and /proc.
+// Fields that cannot be read stay at their "unknown" values (empty / -1).
+struct EnvironmentSnapshot {
+  // cpufreq scaling governor of the measuring CPU, e.g. "performance" or "powersave"
+  std::string governor;
+  // 1 - turbo/boost frequencies enabled, 0 - disabled
+  int turbo = -1;
+  // 1 - SMT siblings active, 0 - inactive
+  int smt = -1;
+  // 1 minute load average
+  double load_average = -1.0;
+  int online_cpus = 0;
+  // kernel list of isolated CPUs, e.g. "2-3"
+  std::string isolated_cpus;
+  // CPU the measuring thread is pinned to
+  int pinned_cpu = -1;
+  // thread placement of the backends, ppc::util::PlacementSummary()
+  std::string affinity;
+  // source of the default timer, e.g. "tsc@2.995GHz" or "steady"
+  std::string timer;
+
+  // single line "governor=.. turbo=.. smt=.. loadavg=.. cpus=.. isolated=.. pinned=.. affinity=.. timer=.."
+  [[nodiscard]] std::string ToString() const;
+};
+
+EnvironmentSnapshot CaptureEnvironment();
+
+// What makes a measurement noisy
+struct NoiseLimits {
+  // load average above this share of the online CPUs means busy neighbors
+  double max_load_per_cpu = 0.5;
+  bool require_performance_governor = true;
+  bool require_turbo_off = true;
+  bool require_smt_off = false;
+};
+
+// Human-readable reasons why the snapshot is noisy (empty - quiet); unknown fields are not reported
+std::vector<std::string> NoiseWarnings(const EnvironmentSnapshot &snapshot, const NoiseLimits &limits);
+
+// Pins the calling thread to one CPU and restores its previous affinity on destruction
+// (Linux only, elsewhere a no-op). Throws std::runtime_error if the CPU is not available.
+class ScopedThreadPin {
+ public:
+  explicit ScopedThreadPin(int cpu);
+  ScopedThreadPin(const ScopedThreadPin &) = delete;
+  ScopedThreadPin &operator=(const ScopedThreadPin &) = delete;
+  ~ScopedThreadPin();
+
+ private:
+  std::vector<uint8_t> previous_mask_;
+};
+
+}  // namespace ppc::core
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace ppc::core {
+
+// Log-bucketed histogram of non-negative values (latencies in nanoseconds):
+// every power of two is split into kSubBuckets linear buckets, so a recorded
+// value is known within 1/kSubBuckets of its magnitude over the whole int64 range
+class LatencyHistogram {
+ public:
+  static constexpr int kSubBucketBits = 6;
+  static constexpr int64_t kSubBuckets = int64_t{1} << kSubBucketBits;
+
+  LatencyHistogram();
+
+  void Record(int64_t value);
+  void Merge(const LatencyHistogram &other);
+  void Clear();
+
+  [[nodiscard]] uint64_t Count() const { return count_; }
+  [[nodiscard]] int64_t Min() const { return count_ == 0 ? 0 : min_; }
+  [[nodiscard]] int64_t Max() const { return max_; }
+  [[nodiscard]] double Mean() const;
+  // upper bound of the bucket holding the q-quantile (q in [0, 1]), 0 if empty
+  [[nodiscard]] int64_t Percentile(double q) const;
+
+ private:
+  static int BucketIndex(int64_t value);
+  static int64_t BucketUpperBound(int index);
+
+  std::vector<uint64_t> counts_;
+  uint64_t count_ = 0;
+  int64_t min_ = 0;
+  int64_t max_ = 0;
+  double sum_ = 0.0;
+};
+
+}  // namespace ppc::core
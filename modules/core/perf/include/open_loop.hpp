@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "core/perf/include/latency_histogram.hpp"
+#include "core/perf/include/throughput.hpp"
+
+namespace ppc::core {
+
+struct LoadAttr {
+  // inter-arrival times: exponential (Poisson process) or fixed
+  enum Arrival : uint8_t { kPoisson, kConstant } arrival = kPoisson;
+  // offered requests per second
+  double rate_per_sec = 100.0;
+  uint64_t num_requests = 1000;
+  // workers of the pool, each owning one task copy (0 - hardware threads)
+  int num_workers = 0;
+  // seed of the arrival schedule
+  uint64_t seed = 0;
+};
+
+struct LoadResults {
+  // requests per second realized by the arrival schedule
+  double offered_rate = 0.0;
+  // completed requests per second from the first arrival to the last completion
+  double achieved_rate = 0.0;
+  // latency from the scheduled arrival to the completion (in nanoseconds), so
+  // time spent queued behind busy workers is included
+  LatencyHistogram latency_ns;
+};
+
+// Open-loop run: requests arrive on a precomputed schedule regardless of how
+// fast earlier ones complete and are served in arrival order by the pool
+LoadResults RunOpenLoad(const TaskFactory &factory, const LoadAttr &attr);
+
+struct SustainableRateAttr {
+  LoadAttr load;
+  // p99 latency considered diverged (0 - ten times the p99 at a light load)
+  double latency_limit_sec = 0.0;
+  // achieved/offered rate below which the backlog is considered growing
+  double min_achieved_fraction = 0.95;
+  // bisection steps after the light load probe
+  int steps = 8;
+};
+
+struct SustainableRateResults {
+  // highest probed rate whose p99 stayed under the limit without backlog
+  double max_rate = 0.0;
+  double latency_limit_sec = 0.0;
+  std::vector<LoadResults> probes;
+};
+
+SustainableRateResults FindMaxSustainableRate(const TaskFactory &factory, const SustainableRateAttr &attr);
+
+// Print a summary line prefixed with `name`
+void PrintLoadResults(const std::string &name, const LoadResults &results);
+void PrintSustainableRate(const std::string &name, const SustainableRateResults &results);
+
+}  // namespace ppc::core
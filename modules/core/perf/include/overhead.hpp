@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace ppc::core {
+
+// Builds the measured operation for `num_threads` threads. Everything the
+// operation reuses (arenas, buffers, communicators) is created here, outside
+// the timed loop.
+using OverheadOpFactory = std::function<std::function<void()>(int num_threads)>;
+
+struct OverheadAttr {
+  // operations timed together, enough to hide the cost of reading the clock
+  uint64_t ops_per_batch = 1000;
+  // timed batches per thread count (after one warm-up batch)
+  int batches = 10;
+  // thread counts double from 1 and the last one is always max_threads
+  // (0 - GetUsableCpuCount())
+  int max_threads = 0;
+};
+
+struct OverheadPoint {
+  int threads = 0;
+  // median, fastest and slowest batch divided by ops_per_batch (in nanoseconds)
+  double ns_per_op = 0.0;
+  double min_ns_per_op = 0.0;
+  double max_ns_per_op = 0.0;
+};
+
+// Cost of one call of the operation for every thread count of the sweep; it
+// includes one std::function call (a few nanoseconds)
+std::vector<OverheadPoint> MeasureOverhead(const OverheadOpFactory &factory, const OverheadAttr &attr);
+
+// Print one line per point prefixed with `name` and `operation`
+void PrintOverhead(const std::string &name, const std::string &operation, const std::vector<OverheadPoint> &points);
+
+}  // namespace ppc::core
@@ -1,23 +1,86 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <string>
+#include <vector>
 
+#include "core/perf/include/environment.hpp"
+#include "core/perf/include/profiler.hpp"
 #include "core/task/include/task.hpp"
+#include "core/trace/include/load_balance.hpp"
 
 namespace ppc::core {
 
 struct PerfAttr {
   // count of task's running
   uint64_t num_running;
-  std::function<double()> current_timer = [&] { return 0.0; };
+  // clock of the measurement in seconds; empty - ppc::util::NowSeconds(), the
+  // calibrated TSC timer (timer.hpp) read without a std::function call
+  std::function<double()> current_timer;
+  // write a Chrome trace of the measured runs to this file (disabled if empty)
+  std::string trace_path;
+  // sample call stacks of all threads during the measured runs and write them
+  // as folded stacks to this file (disabled if empty, see profiler.hpp)
+  std::string profile_path;
+  int profile_frequency_hz = SamplingProfiler::kDefaultFrequencyHz;
+  // collect per-worker busy time of the ParallelRegions executed by the measured runs
+  bool load_balance = false;
+  // cache state before every measured run: kWarm reruns back to back, kCold evicts
+  // caches before each run (outside the timed region), kWarmAndCold measures both
+  enum CacheMode : uint8_t { kWarm, kCold, kWarmAndCold } cache_mode = kWarm;
+  // size of the buffer streamed to evict caches (0 - twice the last level cache)
+  size_t cache_flush_bytes = 0;
+  // byte sizes of task_data->inputs; if set, cold runs of PipelineRun copy inputs
+  // to freshly allocated buffers at random cache line offsets before every run.
+  // Ignored by TaskRun: its PreProcessing reads the inputs once before all runs.
+  std::vector<size_t> input_bytes;
+  // compare achieved rates with the machine peaks of GetPPCNumThreads() threads
+  // (measured once per host, see roofline.hpp)
+  bool roofline = false;
+  // called before every measured run outside the timed region, e.g. a barrier
+  // that aligns the start of all MPI processes (see perf_mpi.hpp)
+  std::function<void()> sync_start;
+  // byte sizes of task_data->outputs; if set with verify_runs, TaskRun checks that
+  // the outputs of repeated Run() calls equal the outputs of a single run
+  std::vector<size_t> output_bytes;
+  bool verify_runs = false;
+  // pin the measuring thread to this CPU for the measurement (-1 - not pinned)
+  int pin_cpu = -1;
+  // reaction to a noisy environment before measuring: kWarn prints the reasons,
+  // kRefuse throws instead of measuring
+  enum NoisePolicy : uint8_t { kIgnore, kWarn, kRefuse } noise_policy = kIgnore;
+  NoiseLimits noise_limits;
 };
 
 struct PerfResults {
   // measurement of task's time (in seconds)
   double time_sec = 0.0;
+  // measurement of task's time with evicted caches (in seconds), 0 if not measured
+  double cold_time_sec = 0.0;
+  // achieved rates of the task's declared work (0 if the task declares none)
+  double gflops = 0.0;
+  double bandwidth_gbs = 0.0;
+  // machine roofs (0 if roofline reporting is off)
+  double peak_gflops = 0.0;
+  double peak_bandwidth_gbs = 0.0;
   enum TypeOfRunning : uint8_t { kPipeline, kTaskRun, kNone } type_of_running = kNone;
+  enum Stage : uint8_t { kValidation, kPreProcessing, kRun, kPostProcessing, kStageCount };
+  // time spent in every stage over all measured runs (in seconds)
+  std::array<double, kStageCount> stage_time_sec{};
+  // time of every measured run (in seconds), the samples of baseline comparisons
+  std::vector<double> run_time_sec;
+  // total element count of the task inputs and the parallel configuration of the run
+  uint64_t input_size = 0;
+  int num_threads = 1;
+  int num_processes = 1;
+  // machine state captured before the measurement
+  EnvironmentSnapshot environment;
+  // work distribution over the parallel regions (regions = 0 if not collected)
+  LoadBalanceSummary load_balance;
   constexpr static double kMaxTime = 10.0;
 };
 
@@ -38,8 +101,16 @@ class Perf {
 
  private:
   std::shared_ptr<Task> task_;
-  static void CommonRun(const std::shared_ptr<PerfAttr>& perf_attr, const std::function<void()>& pipeline,
-                        const std::shared_ptr<PerfResults>& perf_results);
+  void CommonRun(const std::shared_ptr<PerfAttr>& perf_attr, const std::function<void()>& prepare,
+                 const std::function<void()>& pipeline, const std::shared_ptr<PerfResults>& perf_results) const;
+  double ColdRun(const std::shared_ptr<PerfAttr>& perf_attr, const std::function<void()>& prepare,
+                 const std::function<void()>& pipeline, bool relocate_inputs, std::vector<double>& run_times) const;
+  [[nodiscard]] std::vector<std::vector<uint8_t>> CopyOutputs(const std::shared_ptr<PerfAttr>& perf_attr) const;
+  static void CheckNoise(const std::shared_ptr<PerfAttr>& perf_attr, const EnvironmentSnapshot& environment);
+  void FillRoofline(const std::shared_ptr<PerfAttr>& perf_attr, const std::shared_ptr<PerfResults>& perf_results) const;
+  static void PrintRoofline(const std::string& prefix, const std::shared_ptr<PerfResults>& perf_results);
+  static void PrintLoadBalance(const std::string& prefix, const std::shared_ptr<PerfResults>& perf_results);
+  static void PrintSamples(const std::string& prefix, const std::shared_ptr<PerfResults>& perf_results);
 };
 
 }  // namespace ppc::core
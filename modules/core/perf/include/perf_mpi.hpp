@@ -0,0 +1,148 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <array>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "core/perf/include/perf.hpp"
+
+// MPI extension of Perf, header-only so that the core library stays MPI-free:
+// include it from MPI tasks only.
+namespace ppc::core {
+
+// Statistic of one measured time over all processes
+struct MpiTimeStat {
+  double min_sec = 0.0;
+  double avg_sec = 0.0;
+  double max_sec = 0.0;
+  // slowest process relative to the average one (1 - perfectly balanced)
+  [[nodiscard]] double Imbalance() const { return avg_sec > 0.0 ? max_sec / avg_sec : 1.0; }
+};
+
+struct MpiPerfResults {
+  MpiTimeStat total;
+  std::array<MpiTimeStat, PerfResults::kStageCount> stages;
+  // {total, stages...} of every process, gathered on the root only
+  std::vector<std::array<double, PerfResults::kStageCount + 1>> rank_times;
+  // time of every measured run and the cold time on the slowest process, on
+  // the root only
+  std::vector<double> run_max_sec;
+  double cold_max_sec = 0.0;
+};
+
+// Time with MPI_Wtime and start every measured run from a barrier of `comm`
+inline void SetMpiPerfAttr(PerfAttr &perf_attr, MPI_Comm comm = MPI_COMM_WORLD) {
+  perf_attr.current_timer = [] { return MPI_Wtime(); };
+  perf_attr.sync_start = [comm] { MPI_Barrier(comm); };
+}
+
+// `path` with the rank in `comm` appended, so that every process writes its own
+// trace or profile, e.g. "profile.folded" -> "profile.folded.3"
+inline std::string PerRankPath(const std::string &path, MPI_Comm comm = MPI_COMM_WORLD) {
+  int rank = 0;
+  MPI_Comm_rank(comm, &rank);
+  return path + "." + std::to_string(rank);
+}
+
+// Collective: reduce the local results of every process of `comm` on `root`
+inline MpiPerfResults ReduceMpiPerfResults(const PerfResults &perf_results, MPI_Comm comm = MPI_COMM_WORLD,
+                                           int root = 0) {
+  constexpr int kValues = PerfResults::kStageCount + 1;
+  int rank = 0;
+  int size = 1;
+  MPI_Comm_rank(comm, &rank);
+  MPI_Comm_size(comm, &size);
+
+  std::array<double, kValues> local{};
+  local[0] = perf_results.time_sec;
+  for (int i = 0; i < PerfResults::kStageCount; i++) {
+    local[i + 1] = perf_results.stage_time_sec[i];
+  }
+
+  std::array<double, kValues> min{};
+  std::array<double, kValues> max{};
+  std::array<double, kValues> sum{};
+  MPI_Reduce(local.data(), min.data(), kValues, MPI_DOUBLE, MPI_MIN, root, comm);
+  MPI_Reduce(local.data(), max.data(), kValues, MPI_DOUBLE, MPI_MAX, root, comm);
+  MPI_Reduce(local.data(), sum.data(), kValues, MPI_DOUBLE, MPI_SUM, root, comm);
+
+  MpiPerfResults results;
+  if (rank == root) {
+    results.rank_times.resize(size);
+  }
+  double *gathered = rank == root ? results.rank_times.front().data() : nullptr;
+  MPI_Gather(local.data(), kValues, MPI_DOUBLE, gathered, kValues, MPI_DOUBLE, root, comm);
+
+  // every process measures the same number of runs, each started from a barrier
+  const auto &run_times = perf_results.run_time_sec;
+  if (rank == root) {
+    results.run_max_sec.resize(run_times.size());
+  }
+  MPI_Reduce(run_times.data(), results.run_max_sec.data(), static_cast<int>(run_times.size()), MPI_DOUBLE, MPI_MAX,
+             root, comm);
+  MPI_Reduce(&perf_results.cold_time_sec, &results.cold_max_sec, 1, MPI_DOUBLE, MPI_MAX, root, comm);
+
+  auto stat = [&](int i) { return MpiTimeStat{.min_sec = min[i], .avg_sec = sum[i] / size, .max_sec = max[i]}; };
+  results.total = stat(0);
+  for (int i = 0; i < PerfResults::kStageCount; i++) {
+    results.stages[i] = stat(i + 1);
+  }
+  return results;
+}
+
+// Replace the local times of `perf_results` by the reduced ones (call on the
+// root), so that PrintPerfStatistic reports the slowest process of every run:
+// time, samples and cold time, with the achieved rates rescaled to that time.
+// The environment and the load balance stay those of the root.
+inline void SetMpiPerfResults(PerfResults &perf_results, const MpiPerfResults &results,
+                              MPI_Comm comm = MPI_COMM_WORLD) {
+  const double local_time = perf_results.time_sec;
+  perf_results.run_time_sec = results.run_max_sec;
+  perf_results.time_sec = 0.0;
+  for (double run_time : results.run_max_sec) {
+    perf_results.time_sec += run_time;
+  }
+  perf_results.cold_time_sec = results.cold_max_sec;
+  if (perf_results.time_sec > 0.0) {
+    perf_results.gflops *= local_time / perf_results.time_sec;
+    perf_results.bandwidth_gbs *= local_time / perf_results.time_sec;
+  }
+  MPI_Comm_size(comm, &perf_results.num_processes);
+}
+
+// Print the cross-process statistic (call on the root)
+inline void PrintMpiPerfStatistic(const MpiPerfResults &results) {
+  constexpr std::array<const char *, PerfResults::kStageCount> kStageNames = {"Validation", "PreProcessing", "Run",
+                                                                              "PostProcessing"};
+  // formatted apart, so that the flags of std::cout stay untouched
+  std::stringstream out;
+  auto print_stat = [&out](const char *name, const MpiTimeStat &stat) {
+    out << "mpi:" << name << ": min=" << stat.min_sec << " avg=" << stat.avg_sec << " max=" << stat.max_sec
+        << " imbalance=" << stat.Imbalance() << '\n';
+  };
+
+  out << std::fixed << std::setprecision(10);
+  print_stat("total", results.total);
+  for (int i = 0; i < PerfResults::kStageCount; i++) {
+    if (results.stages[i].max_sec > 0.0) {
+      print_stat(kStageNames[i], results.stages[i]);
+    }
+  }
+  for (size_t rank = 0; rank < results.rank_times.size(); rank++) {
+    const auto &times = results.rank_times[rank];
+    out << "mpi:rank " << rank << ": total=" << times[0];
+    for (int i = 0; i < PerfResults::kStageCount; i++) {
+      out << ' ' << kStageNames[i] << '=' << times[i + 1];
+    }
+    out << '\n';
+  }
+  std::cout << out.str();
+}
+
+}  // namespace ppc::core
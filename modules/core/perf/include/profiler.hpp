@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+
+namespace ppc::core {
+
+// Statistical CPU profiler: a process CPU-time timer (setitimer/SIGPROF) interrupts
+// whichever thread is running and the signal handler stores its call stack into a
+// preallocated buffer. Stacks are symbolized only when written out. Works in every
+// MPI process independently; write each rank to its own file (see PerRankPath in
+// perf_mpi.hpp). POSIX only: Start() throws elsewhere.
+// Function names of the executable itself need it to be linked with -rdynamic,
+// otherwise frames are written as module+offset (resolvable with addr2line).
+class SamplingProfiler {
+ public:
+  // start sampling at `frequency_hz` samples per CPU second, dropping previous samples
+  static void Start(int frequency_hz = kDefaultFrequencyHz);
+  static void Stop();
+  static bool IsRunning();
+
+  // stacks recorded / lost because the buffer was full
+  static size_t SampleCount();
+  static size_t DroppedCount();
+
+  // folded stacks ("root;caller;callee count" per line) for flamegraph.pl / speedscope
+  static void WriteFolded(std::ostream &out);
+  static void WriteFolded(const std::string &path);
+
+  static constexpr int kDefaultFrequencyHz = 999;
+  static constexpr int kMaxDepth = 64;
+  static constexpr size_t kMaxSamples = size_t{1} << 14;
+};
+
+}  // namespace ppc::core
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace ppc::core {
+
+// Machine roofs measured by built-in microbenchmarks
+struct MachinePeaks {
+  // STREAM triad bandwidth (GB/s)
+  double bandwidth_gbs = 0.0;
+  // multiply-add throughput of the instruction set kernels dispatch to, with
+  // FMA on AVX2 and AVX-512 (GFLOP/s)
+  double gflops = 0.0;
+};
+
+// Run STREAM triad over three arrays of `stream_bytes` total size (0 - sized
+// from the last level cache) and a multiply-add loop on `num_threads` threads
+MachinePeaks MeasureMachinePeaks(int num_threads, size_t stream_bytes = 0);
+
+// Cached peaks of this host and dispatch level for the given thread count,
+// measured on first use. The cache lives in $PPC_PERF_CACHE_DIR (or the temp
+// directory).
+MachinePeaks GetMachinePeaks(int num_threads);
+std::string GetMachinePeaksCachePath();
+
+}  // namespace ppc::core
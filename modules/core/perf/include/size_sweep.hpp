@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/task/include/task.hpp"
+
+namespace ppc::core {
+
+// A task built for one input size together with the buffers its TaskData points to
+struct SizedTask {
+  std::shared_ptr<Task> task;
+  std::shared_ptr<void> storage;
+};
+
+// Builds the task for input size `n`; the meaning of `n` (elements, matrix rows, points)
+// is up to the generator and is the variable of the complexity fit
+using InputGenerator = std::function<SizedTask(uint64_t n)>;
+
+// Generators registered by name so that sweeps can be requested per task
+void RegisterInputGenerator(const std::string &name, InputGenerator generator);
+// Throws std::invalid_argument for unknown names
+const InputGenerator &GetInputGenerator(const std::string &name);
+
+struct SizeSweepAttr {
+  uint64_t min_n = 1024;
+  uint64_t max_n = uint64_t{1} << 24;
+  // ratio of consecutive sizes
+  double factor = 2.0;
+  // every size is rerun until both limits are reached, the fastest run is kept
+  uint64_t min_runs = 3;
+  double min_time_sec = 0.05;
+  // relative throughput loss against the previous size reported as a drop
+  double drop_threshold = 0.15;
+};
+
+struct SizePoint {
+  uint64_t n = 0;
+  // fastest Run() (in seconds)
+  double time_sec = 0.0;
+  // declared work per second (GetFlopsPerRun, or n if the task declares none)
+  double throughput = 0.0;
+  // declared bytes of one Run(), 0 if the task declares none
+  double working_set_bytes = 0.0;
+  // memory level the working set fits in: "L2", "LLC" or "DRAM" (empty if unknown)
+  std::string level;
+  bool throughput_drop = false;
+};
+
+// time ~= c * n^k over the points [first, last] of one band
+struct ComplexityBand {
+  size_t first = 0;
+  size_t last = 0;
+  double c = 0.0;
+  double k = 0.0;
+};
+
+struct SizeSweepResults {
+  std::vector<SizePoint> points;
+  // split where the memory level changes or throughput drops
+  std::vector<ComplexityBand> bands;
+};
+
+SizeSweepResults MeasureSizeSweep(const InputGenerator &generator, const SizeSweepAttr &attr);
+
+// Print one line per point and per band prefixed with `name`
+void PrintSizeSweep(const std::string &name, const SizeSweepResults &results);
+
+}  // namespace ppc::core
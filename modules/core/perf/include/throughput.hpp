@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/task/include/task.hpp"
+
+namespace ppc::core {
+
+// Creates the copy number `copy` of a task with its own TaskData; the data must
+// outlive the measurement
+using TaskFactory = std::function<std::shared_ptr<Task>(int copy)>;
+
+struct ThroughputAttr {
+  // full pipeline runs of every copy per measured point
+  uint64_t runs_per_copy = 10;
+  // largest number of concurrent copies (0 - GetUsableCpuCount()); K doubles from 1
+  // and the last point is always max_concurrency
+  int max_concurrency = 0;
+};
+
+struct ThroughputPoint {
+  // number of copies running concurrently
+  int concurrency = 0;
+  // from the common start to the end of the last copy (in seconds)
+  double wall_sec = 0.0;
+  // completed pipelines per second over all copies
+  double tasks_per_sec = 0.0;
+  // time of one pipeline run (in seconds)
+  double latency_avg_sec = 0.0;
+  double latency_p50_sec = 0.0;
+  double latency_max_sec = 0.0;
+  // tasks_per_sec relative to K uncontended copies (1 - no contention)
+  double scaling = 0.0;
+};
+
+// Runs K independent copies of a task concurrently, one per thread of a pool
+// started for the sweep, for every K of the sweep. Copies are created once up
+// front and reused by all points.
+std::vector<ThroughputPoint> MeasureThroughput(const TaskFactory &factory, const ThroughputAttr &attr);
+
+// Print one line per point prefixed with `name`
+void PrintThroughput(const std::string &name, const std::vector<ThroughputPoint> &points);
+
+}  // namespace ppc::core
@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <cstddef>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "core/perf/include/overhead.hpp"
+#include "core/util/include/thread_pool.hpp"
+#include "core/util/include/util.hpp"
+
+// Fork/join cost of the parallel runtimes the tasks are built on. The TBB
+// benchmarks are in overhead_tbb_perf_tests, built only with USE_TBB.
+
+#ifdef _OPENMP
+// An empty parallel region per operation. The body only queries the thread
+// number, since compilers drop parallel regions without a body.
+TEST(overhead_perf_tests, test_omp_parallel_region) {
+  auto factory = [](int num_threads) -> std::function<void()> {
+    return [num_threads] {
+#pragma omp parallel num_threads(num_threads)
+      {
+        if (omp_get_thread_num() < 0) {
+          std::abort();
+        }
+      }
+    };
+  };
+
+  ppc::core::OverheadAttr attr;
+  attr.max_threads = ppc::util::GetPPCNumThreads();
+  const auto points = ppc::core::MeasureOverhead(factory, attr);
+  ppc::core::PrintOverhead("core", "omp_parallel_region", points);
+
+  ASSERT_FALSE(points.empty());
+}
+#endif
+
+// Creating and joining the threads of one Run(), as the STL example does on
+// every call
+TEST(overhead_perf_tests, test_thread_create_join) {
+  auto factory = [](int num_threads) -> std::function<void()> {
+    return [num_threads] {
+      std::vector<std::thread> threads;
+      threads.reserve(num_threads);
+      for (int i = 0; i < num_threads; i++) {
+        threads.emplace_back([] {});
+      }
+      for (auto &thread : threads) {
+        thread.join();
+      }
+    };
+  };
+
+  ppc::core::OverheadAttr attr;
+  attr.ops_per_batch = 200;
+  attr.max_threads = ppc::util::GetPPCNumThreads();
+  const auto points = ppc::core::MeasureOverhead(factory, attr);
+  ppc::core::PrintOverhead("core", "thread_create_join", points);
+
+  ASSERT_FALSE(points.empty());
+}
+
+// The same fork/join on a persistent work-stealing pool: one empty chunk per
+// thread, compare with test_thread_create_join
+TEST(overhead_perf_tests, test_thread_pool) {
+  auto factory = [](int num_threads) -> std::function<void()> {
+    auto pool = std::make_shared<ppc::util::ThreadPool>(num_threads);
+    return [pool, num_threads] { pool->ParallelFor(0, num_threads, [](size_t, size_t) {}, 1); };
+  };
+
+  ppc::core::OverheadAttr attr;
+  attr.max_threads = ppc::util::GetPPCNumThreads();
+  const auto points = ppc::core::MeasureOverhead(factory, attr);
+  ppc::core::PrintOverhead("core", "thread_pool", points);
+
+  ASSERT_FALSE(points.empty());
+}
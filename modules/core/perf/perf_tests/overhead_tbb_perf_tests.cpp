@@ -0,0 +1,35 @@
+#include <gtest/gtest.h>
+
+#include <functional>
+#include <memory>
+
+#include "core/perf/include/overhead.hpp"
+#include "core/util/include/util.hpp"
+#include "oneapi/tbb/task_arena.h"
+#include "oneapi/tbb/task_group.h"
+
+// Spawn/wait cost of the TBB scheduler, built only with USE_TBB: one empty
+// task per arena thread in a task_group, executed inside a task_arena of the
+// measured size. Compare with overhead_perf_tests.
+TEST(overhead_tbb_perf_tests, test_task_group) {
+  auto factory = [](int num_threads) -> std::function<void()> {
+    auto arena = std::make_shared<oneapi::tbb::task_arena>(num_threads);
+    return [arena, num_threads] {
+      arena->execute([num_threads] {
+        oneapi::tbb::task_group group;
+        for (int i = 0; i < num_threads; i++) {
+          group.run([] {});
+        }
+        group.wait();
+      });
+    };
+  };
+
+  ppc::core::OverheadAttr attr;
+  attr.ops_per_batch = 200;
+  attr.max_threads = ppc::util::GetPPCNumThreads();
+  const auto points = ppc::core::MeasureOverhead(factory, attr);
+  ppc::core::PrintOverhead("core", "tbb_task_group", points);
+
+  ASSERT_FALSE(points.empty());
+}
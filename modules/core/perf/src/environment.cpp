@@ -0,0 +1,141 @@
+#include "core/perf/include/environment.hpp"
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/util/include/affinity.hpp"
+#include "core/util/include/timer.hpp"
+
+namespace {
+
+const std::string kCpuSysfs = "/sys/devices/system/cpu/";
+
+std::string ReadFirstLine(const std::string &path) {
+  std::ifstream file(path);
+  std::string line;
+  std::getline(file, line);
+  return line;
+}
+
+int ReadFlag(const std::string &path) {
+  const std::string value = ReadFirstLine(path);
+  if (value.empty() || (value[0] != '0' && value[0] != '1')) {
+    return -1;
+  }
+  return value[0] == '1' ? 1 : 0;
+}
+
+int CurrentCpu() {
+#ifdef __linux__
+  return sched_getcpu();
+#else
+  return -1;
+#endif
+}
+
+}  // namespace
+
+std::string ppc::core::EnvironmentSnapshot::ToString() const {
+  auto flag = [](int value) { return value < 0 ? "unknown" : (value == 1 ? "on" : "off"); };
+  std::stringstream out;
+  out << "governor=" << (governor.empty() ? "unknown" : governor) << " turbo=" << flag(turbo)
+      << " smt=" << flag(smt) << " loadavg=" << std::fixed << std::setprecision(2) << load_average
+      << " cpus=" << online_cpus << " isolated=" << (isolated_cpus.empty() ? "none" : isolated_cpus)
+      << " pinned=" << pinned_cpu << " affinity=" << (affinity.empty() ? "none" : affinity)
+      << " timer=" << (timer.empty() ? "unknown" : timer);
+  return out.str();
+}
+
+ppc::core::EnvironmentSnapshot ppc::core::CaptureEnvironment() {
+  EnvironmentSnapshot snapshot;
+  snapshot.online_cpus = static_cast<int>(std::thread::hardware_concurrency());
+
+  const int cpu = CurrentCpu();
+  snapshot.governor =
+      ReadFirstLine(kCpuSysfs + "cpu" + std::to_string(cpu < 0 ? 0 : cpu) + "/cpufreq/scaling_governor");
+
+  // intel_pstate reports the inverse flag, other drivers expose the generic boost switch
+  const int no_turbo = ReadFlag(kCpuSysfs + "intel_pstate/no_turbo");
+  snapshot.turbo = no_turbo >= 0 ? 1 - no_turbo : ReadFlag(kCpuSysfs + "cpufreq/boost");
+  snapshot.smt = ReadFlag(kCpuSysfs + "smt/active");
+  snapshot.isolated_cpus = ReadFirstLine(kCpuSysfs + "isolated");
+  snapshot.affinity = ppc::util::PlacementSummary();
+  const auto &calibration = ppc::util::GetTimerCalibration();
+  snapshot.timer = ppc::util::TimerSourceName(calibration.source);
+  if (calibration.source == ppc::util::TimerSource::kTsc) {
+    std::stringstream rate;
+    rate << std::fixed << std::setprecision(3) << 1e-9 / calibration.seconds_per_tick << "GHz";
+    snapshot.timer += "@" + rate.str();
+  }
+
+  std::ifstream loadavg("/proc/loadavg");
+  if (!(loadavg >> snapshot.load_average)) {
+    snapshot.load_average = -1.0;
+  }
+  return snapshot;
+}
+
+std::vector<std::string> ppc::core::NoiseWarnings(const EnvironmentSnapshot &snapshot, const NoiseLimits &limits) {
+  std::vector<std::string> warnings;
+  if (limits.require_performance_governor && !snapshot.governor.empty() && snapshot.governor != "performance") {
+    warnings.emplace_back("CPU frequency governor is '" + snapshot.governor + "', not 'performance'");
+  }
+  if (limits.require_turbo_off && snapshot.turbo == 1) {
+    warnings.emplace_back("turbo frequencies are enabled");
+  }
+  if (limits.require_smt_off && snapshot.smt == 1) {
+    warnings.emplace_back("SMT siblings are active");
+  }
+  if (snapshot.load_average >= 0.0 && snapshot.online_cpus > 0 &&
+      snapshot.load_average > limits.max_load_per_cpu * snapshot.online_cpus) {
+    std::stringstream message;
+    message << "load average " << std::fixed << std::setprecision(2) << snapshot.load_average << " on "
+            << snapshot.online_cpus << " CPUs";
+    warnings.emplace_back(message.str());
+  }
+  return warnings;
+}
+
+ppc::core::ScopedThreadPin::ScopedThreadPin(int cpu) {
+#ifdef __linux__
+  cpu_set_t previous;
+  if (sched_getaffinity(0, sizeof(previous), &previous) != 0) {
+    throw std::runtime_error("sched_getaffinity failed");
+  }
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  if (cpu < 0 || cpu >= CPU_SETSIZE) {
+    throw std::runtime_error("Can't pin to CPU " + std::to_string(cpu));
+  }
+  CPU_SET(cpu, &mask);
+  if (sched_setaffinity(0, sizeof(mask), &mask) != 0) {
+    throw std::runtime_error("Can't pin to CPU " + std::to_string(cpu));
+  }
+  previous_mask_.resize(sizeof(previous));
+  std::memcpy(previous_mask_.data(), &previous, sizeof(previous));
+#else
+  (void)cpu;
+#endif
+}
+
+ppc::core::ScopedThreadPin::~ScopedThreadPin() {
+#ifdef __linux__
+  if (previous_mask_.size() == sizeof(cpu_set_t)) {
+    cpu_set_t previous;
+    std::memcpy(&previous, previous_mask_.data(), sizeof(previous));
+    sched_setaffinity(0, sizeof(previous), &previous);
+  }
+#endif
+}
@@ -0,0 +1,87 @@
+#include "core/perf/include/latency_histogram.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+namespace {
+
+// values below kSubBuckets are stored exactly, every further power of two gets kSubBuckets buckets
+constexpr int kBucketCount =
+    (64 - ppc::core::LatencyHistogram::kSubBucketBits) * ppc::core::LatencyHistogram::kSubBuckets;
+
+}  // namespace
+
+ppc::core::LatencyHistogram::LatencyHistogram() : counts_(kBucketCount, 0) {}
+
+int ppc::core::LatencyHistogram::BucketIndex(int64_t value) {
+  const auto v = static_cast<uint64_t>(value);
+  if (v < static_cast<uint64_t>(kSubBuckets)) {
+    return static_cast<int>(v);
+  }
+  // shift that brings the value into [kSubBuckets, 2 * kSubBuckets)
+  const int shift = static_cast<int>(std::bit_width(v)) - kSubBucketBits - 1;
+  return static_cast<int>(((shift + 1) * kSubBuckets) + static_cast<int64_t>(v >> shift) - kSubBuckets);
+}
+
+int64_t ppc::core::LatencyHistogram::BucketUpperBound(int index) {
+  if (index < kSubBuckets) {
+    return index;
+  }
+  const int shift = static_cast<int>(index / kSubBuckets) - 1;
+  const int64_t sub = (index % kSubBuckets) + kSubBuckets;
+  return ((sub + 1) << shift) - 1;
+}
+
+void ppc::core::LatencyHistogram::Record(int64_t value) {
+  if (value < 0) {
+    throw std::invalid_argument("LatencyHistogram: negative value");
+  }
+  counts_[BucketIndex(value)]++;
+  min_ = count_ == 0 ? value : std::min(min_, value);
+  max_ = std::max(max_, value);
+  sum_ += static_cast<double>(value);
+  count_++;
+}
+
+void ppc::core::LatencyHistogram::Merge(const LatencyHistogram &other) {
+  if (other.count_ == 0) {
+    return;
+  }
+  for (size_t i = 0; i < counts_.size(); i++) {
+    counts_[i] += other.counts_[i];
+  }
+  min_ = count_ == 0 ? other.min_ : std::min(min_, other.min_);
+  max_ = std::max(max_, other.max_);
+  sum_ += other.sum_;
+  count_ += other.count_;
+}
+
+void ppc::core::LatencyHistogram::Clear() {
+  std::ranges::fill(counts_, 0);
+  count_ = 0;
+  min_ = 0;
+  max_ = 0;
+  sum_ = 0.0;
+}
+
+double ppc::core::LatencyHistogram::Mean() const { return count_ == 0 ? 0.0 : sum_ / static_cast<double>(count_); }
+
+int64_t ppc::core::LatencyHistogram::Percentile(double q) const {
+  if (count_ == 0) {
+    return 0;
+  }
+  q = std::clamp(q, 0.0, 1.0);
+  const auto rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(q * static_cast<double>(count_))));
+  uint64_t seen = 0;
+  for (size_t i = 0; i < counts_.size(); i++) {
+    seen += counts_[i];
+    if (seen >= rank) {
+      return std::clamp(BucketUpperBound(static_cast<int>(i)), min_, max_);
+    }
+  }
+  return max_;
+}
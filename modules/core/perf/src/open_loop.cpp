@@ -0,0 +1,195 @@
+#include "core/perf/include/open_loop.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/perf/include/latency_histogram.hpp"
+#include "core/perf/include/throughput.hpp"
+#include "core/task/include/task.hpp"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr auto kSpinThreshold = std::chrono::microseconds(100);
+constexpr double kNsInSec = 1e9;
+constexpr int kServiceSamples = 5;
+
+std::vector<std::shared_ptr<ppc::core::Task>> CreateWorkerCopies(const ppc::core::TaskFactory &factory,
+                                                                 int num_workers) {
+  std::vector<std::shared_ptr<ppc::core::Task>> copies;
+  for (int copy = 0; copy < num_workers; copy++) {
+    copies.push_back(factory(copy));
+    copies.back()->GetData()->state_of_testing = ppc::core::TaskData::StateOfTesting::kPerf;
+  }
+  return copies;
+}
+
+// Arrival offsets from the start of the run (in nanoseconds)
+std::vector<int64_t> ArrivalSchedule(const ppc::core::LoadAttr &attr) {
+  std::vector<int64_t> schedule(attr.num_requests);
+  std::mt19937_64 gen(attr.seed);
+  std::exponential_distribution<double> gap(attr.rate_per_sec);
+  double t = 0.0;
+  for (auto &arrival : schedule) {
+    arrival = static_cast<int64_t>(t * kNsInSec);
+    t += attr.arrival == ppc::core::LoadAttr::kPoisson ? gap(gen) : 1.0 / attr.rate_per_sec;
+  }
+  return schedule;
+}
+
+// Sleeps through long waits and spins the last microseconds for precise release
+void WaitUntil(Clock::time_point deadline) {
+  for (auto now = Clock::now(); now < deadline; now = Clock::now()) {
+    if (deadline - now > kSpinThreshold) {
+      std::this_thread::sleep_for(deadline - now - kSpinThreshold);
+    } else {
+      std::this_thread::yield();
+    }
+  }
+}
+
+void RunPipeline(ppc::core::Task &task) {
+  task.Validation();
+  task.PreProcessing();
+  task.Run();
+  task.PostProcessing();
+}
+
+ppc::core::LoadResults RunOnCopies(const std::vector<std::shared_ptr<ppc::core::Task>> &copies,
+                                   const ppc::core::LoadAttr &attr) {
+  if (attr.rate_per_sec <= 0.0 || attr.num_requests == 0) {
+    throw std::invalid_argument("LoadAttr: rate_per_sec and num_requests must be positive");
+  }
+  const std::vector<int64_t> schedule = ArrivalSchedule(attr);
+  const int num_workers = static_cast<int>(copies.size());
+  std::vector<ppc::core::LatencyHistogram> histograms(num_workers);
+  std::vector<Clock::time_point> last_done(num_workers);
+  // next request in arrival order; a worker that takes it early waits for its arrival,
+  // one that takes it late has left it queued, which is what the latency accounts for
+  std::atomic<uint64_t> next{0};
+  const Clock::time_point start = Clock::now() + std::chrono::milliseconds(1);
+
+  auto worker = [&](int id) {
+    for (uint64_t request = next.fetch_add(1); request < attr.num_requests; request = next.fetch_add(1)) {
+      const Clock::time_point arrival = start + std::chrono::nanoseconds(schedule[request]);
+      WaitUntil(arrival);
+      RunPipeline(*copies[id]);
+      last_done[id] = Clock::now();
+      histograms[id].Record(std::chrono::duration_cast<std::chrono::nanoseconds>(last_done[id] - arrival).count());
+    }
+  };
+  std::vector<std::thread> threads;
+  for (int id = 1; id < num_workers; id++) {
+    threads.emplace_back(worker, id);
+  }
+  worker(0);
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  ppc::core::LoadResults results;
+  // the rate the schedule actually realized, which differs from the nominal one for Poisson arrivals
+  results.offered_rate = static_cast<double>(attr.num_requests) /
+                         ((static_cast<double>(schedule.back()) / kNsInSec) + (1.0 / attr.rate_per_sec));
+  for (const auto &histogram : histograms) {
+    results.latency_ns.Merge(histogram);
+  }
+  const double duration = std::chrono::duration<double>(*std::ranges::max_element(last_done) - start).count();
+  results.achieved_rate = duration > 0.0 ? static_cast<double>(attr.num_requests) / duration : 0.0;
+  return results;
+}
+
+bool Sustained(const ppc::core::LoadResults &results, const ppc::core::SustainableRateAttr &attr,
+               double latency_limit_sec) {
+  const double p99_sec = static_cast<double>(results.latency_ns.Percentile(0.99)) / kNsInSec;
+  return p99_sec <= latency_limit_sec && results.achieved_rate >= attr.min_achieved_fraction * results.offered_rate;
+}
+
+int WorkerCount(int num_workers) {
+  return num_workers > 0 ? num_workers : std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+}
+
+}  // namespace
+
+ppc::core::LoadResults ppc::core::RunOpenLoad(const TaskFactory &factory, const LoadAttr &attr) {
+  return RunOnCopies(CreateWorkerCopies(factory, WorkerCount(attr.num_workers)), attr);
+}
+
+ppc::core::SustainableRateResults ppc::core::FindMaxSustainableRate(const TaskFactory &factory,
+                                                                    const SustainableRateAttr &attr) {
+  const int num_workers = WorkerCount(attr.load.num_workers);
+  const auto copies = CreateWorkerCopies(factory, num_workers);
+
+  // unloaded service time bounds the capacity of the pool
+  LatencyHistogram service_ns;
+  for (int i = 0; i < kServiceSamples; i++) {
+    const auto begin = Clock::now();
+    RunPipeline(*copies.front());
+    service_ns.Record(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - begin).count());
+  }
+  const double service_sec = std::max(static_cast<double>(service_ns.Percentile(0.5)) / kNsInSec, 1e-9);
+  const int hardware_threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+  const double capacity = std::min(num_workers, hardware_threads) / service_sec;
+
+  // a light load shows the latency of the pool without queueing
+  LoadAttr load = attr.load;
+  load.rate_per_sec = 0.1 * capacity;
+  SustainableRateResults results;
+  results.probes.push_back(RunOnCopies(copies, load));
+  const double light_p99_sec = static_cast<double>(results.probes.back().latency_ns.Percentile(0.99)) / kNsInSec;
+  results.latency_limit_sec = attr.latency_limit_sec > 0.0 ? attr.latency_limit_sec : 10.0 * light_p99_sec;
+
+  double low = 0.0;
+  double high = 1.5 * capacity;
+  if (Sustained(results.probes.back(), attr, results.latency_limit_sec)) {
+    low = load.rate_per_sec;
+    results.max_rate = low;
+  } else {
+    high = load.rate_per_sec;
+  }
+  for (int step = 0; step < attr.steps; step++) {
+    load.rate_per_sec = 0.5 * (low + high);
+    results.probes.push_back(RunOnCopies(copies, load));
+    if (Sustained(results.probes.back(), attr, results.latency_limit_sec)) {
+      low = load.rate_per_sec;
+      results.max_rate = low;
+    } else {
+      high = load.rate_per_sec;
+    }
+  }
+  return results;
+}
+
+void ppc::core::PrintLoadResults(const std::string &name, const LoadResults &results) {
+  const auto &hist = results.latency_ns;
+  auto sec = [](int64_t ns) { return static_cast<double>(ns) / kNsInSec; };
+  std::stringstream line;
+  line << name << ":open_loop:rate=" << std::fixed << std::setprecision(3) << results.offered_rate
+       << " achieved=" << results.achieved_rate << std::setprecision(10) << " p50=" << sec(hist.Percentile(0.5))
+       << " p99=" << sec(hist.Percentile(0.99)) << " p99.9=" << sec(hist.Percentile(0.999))
+       << " max=" << sec(hist.Max());
+  std::cout << line.str() << '\n';
+}
+
+void ppc::core::PrintSustainableRate(const std::string &name, const SustainableRateResults &results) {
+  for (const auto &probe : results.probes) {
+    PrintLoadResults(name, probe);
+  }
+  std::stringstream line;
+  line << name << ":open_loop:max_sustainable_rate=" << std::fixed << std::setprecision(3) << results.max_rate
+       << std::setprecision(10) << " p99_limit=" << results.latency_limit_sec;
+  std::cout << line.str() << '\n';
+}
@@ -0,0 +1,73 @@
+#include "core/perf/include/overhead.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "core/util/include/util.hpp"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+std::vector<int> ThreadSweep(int max_threads) {
+  std::vector<int> sweep;
+  for (int threads = 1; threads < max_threads; threads *= 2) {
+    sweep.push_back(threads);
+  }
+  sweep.push_back(max_threads);
+  return sweep;
+}
+
+double BatchNsPerOp(const std::function<void()> &op, uint64_t ops_per_batch) {
+  const auto begin = Clock::now();
+  for (uint64_t i = 0; i < ops_per_batch; i++) {
+    op();
+  }
+  const auto end = Clock::now();
+  return std::chrono::duration<double, std::nano>(end - begin).count() / static_cast<double>(ops_per_batch);
+}
+
+}  // namespace
+
+std::vector<ppc::core::OverheadPoint> ppc::core::MeasureOverhead(const OverheadOpFactory &factory,
+                                                                 const OverheadAttr &attr) {
+  if (attr.ops_per_batch == 0 || attr.batches <= 0) {
+    throw std::invalid_argument("OverheadAttr::ops_per_batch and OverheadAttr::batches must be positive");
+  }
+  const int max_threads = attr.max_threads > 0 ? attr.max_threads : ppc::util::GetUsableCpuCount();
+
+  std::vector<OverheadPoint> points;
+  for (int threads : ThreadSweep(max_threads)) {
+    const auto op = factory(threads);
+    // first batch wakes up the runtime (thread teams, arenas, page faults)
+    BatchNsPerOp(op, attr.ops_per_batch);
+    std::vector<double> batches(attr.batches);
+    for (auto &batch : batches) {
+      batch = BatchNsPerOp(op, attr.ops_per_batch);
+    }
+    std::ranges::sort(batches);
+    points.push_back(OverheadPoint{.threads = threads,
+                                   .ns_per_op = batches[batches.size() / 2],
+                                   .min_ns_per_op = batches.front(),
+                                   .max_ns_per_op = batches.back()});
+  }
+  return points;
+}
+
+void ppc::core::PrintOverhead(const std::string &name, const std::string &operation,
+                              const std::vector<OverheadPoint> &points) {
+  for (const auto &point : points) {
+    std::stringstream line;
+    line << name << ":overhead:" << operation << " threads=" << point.threads << std::fixed << std::setprecision(1)
+         << " ns/op=" << point.ns_per_op << " min=" << point.min_ns_per_op << " max=" << point.max_ns_per_op;
+    std::cout << line.str() << '\n';
+  }
+}
@@ -2,16 +2,140 @@
 
 #include <gtest/gtest.h>
 
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <functional>
 #include <iomanip>
 #include <iostream>
 #include <memory>
+#include <numeric>
+#include <optional>
+#include <random>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <utility>
+#include <vector>
 
+#include "core/perf/include/environment.hpp"
+#include "core/perf/include/profiler.hpp"
+#include "core/perf/include/roofline.hpp"
 #include "core/task/include/task.hpp"
+#include "core/trace/include/load_balance.hpp"
+#include "core/trace/include/trace.hpp"
+#include "core/util/include/timer.hpp"
+#include "core/util/include/util.hpp"
+
+namespace {
+
+constexpr size_t kCacheLine = 64;
+constexpr size_t kDefaultFlushBytes = size_t{64} << 20;
+
+// PerfAttr::current_timer, or the calibrated timer read inline when it is empty
+class RunClock {
+ public:
+  explicit RunClock(const std::function<double()> &custom) : custom_(custom) {}
+
+  double operator()() const { return custom_ ? custom_() : ppc::util::NowSeconds(); }
+
+ private:
+  const std::function<double()> &custom_;
+};
+
+// Streams a buffer larger than the last level cache so the next run starts from memory
+class CacheFlusher {
+ public:
+  explicit CacheFlusher(size_t bytes) : buffer_(bytes == 0 ? DefaultSize() : bytes) {}
+
+  void Flush() {
+    for (size_t i = 0; i < buffer_.size(); i += kCacheLine) {
+      buffer_[i]++;
+    }
+    sink_ = sink_ + buffer_[buffer_.size() / 2];
+  }
+
+ private:
+  static size_t DefaultSize() {
+    const size_t llc = ppc::util::GetLastLevelCacheSize();
+    return llc == 0 ? kDefaultFlushBytes : 2 * llc;
+  }
+
+  std::vector<uint8_t> buffer_;
+  volatile uint8_t sink_ = 0;
+};
+
+// Copies task inputs to fresh allocations at random cache line offsets and restores them on destruction
+class InputRelocator {
+ public:
+  InputRelocator(ppc::core::TaskData &task_data, const std::vector<size_t> &input_bytes)
+      : task_data_(task_data), input_bytes_(input_bytes), original_(task_data.inputs) {
+    if (input_bytes_.size() > original_.size()) {
+      throw std::invalid_argument("PerfAttr::input_bytes has more entries than task inputs");
+    }
+  }
+  InputRelocator(const InputRelocator &) = delete;
+  InputRelocator &operator=(const InputRelocator &) = delete;
+  ~InputRelocator() { task_data_.inputs = original_; }
+
+  void Relocate() {
+    std::uniform_int_distribution<size_t> offset_dist(0, kMaxOffsetLines);
+    storage_.resize(input_bytes_.size());
+    for (size_t i = 0; i < input_bytes_.size(); i++) {
+      const size_t offset = offset_dist(gen_) * kCacheLine;
+      storage_[i] = std::vector<uint8_t>(input_bytes_[i] + offset);
+      std::memcpy(storage_[i].data() + offset, original_[i], input_bytes_[i]);
+      task_data_.inputs[i] = storage_[i].data() + offset;
+    }
+  }
+
+ private:
+  static constexpr size_t kMaxOffsetLines = 63;
+
+  ppc::core::TaskData &task_data_;
+  const std::vector<size_t> &input_bytes_;
+  std::vector<uint8_t *> original_;
+  std::vector<std::vector<uint8_t>> storage_;
+  std::mt19937 gen_{std::random_device{}()};
+};
+
+// Records trace spans for its lifetime, so that a throwing run does not leave
+// tracing on for the rest of the process
+class TracingScope {
+ public:
+  TracingScope() {
+    ppc::core::Trace::Clear();
+    ppc::core::Trace::Enable();
+  }
+  TracingScope(const TracingScope &) = delete;
+  TracingScope &operator=(const TracingScope &) = delete;
+  ~TracingScope() { ppc::core::Trace::Disable(); }
+};
+
+// Accounts parallel regions for its lifetime, so that a throwing run does not
+// leave the accounting on for the rest of the process
+class LoadBalanceScope {
+ public:
+  LoadBalanceScope() {
+    ppc::core::LoadBalance::Clear();
+    ppc::core::LoadBalance::Enable();
+  }
+  LoadBalanceScope(const LoadBalanceScope &) = delete;
+  LoadBalanceScope &operator=(const LoadBalanceScope &) = delete;
+  ~LoadBalanceScope() { ppc::core::LoadBalance::Disable(); }
+};
+
+// Samples for its lifetime, so that a throwing run does not leave ITIMER_PROF
+// armed and the SIGPROF handler installed
+class ProfilingScope {
+ public:
+  explicit ProfilingScope(int frequency_hz) { ppc::core::SamplingProfiler::Start(frequency_hz); }
+  ProfilingScope(const ProfilingScope &) = delete;
+  ProfilingScope &operator=(const ProfilingScope &) = delete;
+  ~ProfilingScope() { ppc::core::SamplingProfiler::Stop(); }
+};
+
+}  // namespace
 
 ppc::core::Perf::Perf(const std::shared_ptr<Task>& task_ptr) { SetTask(task_ptr); }
 
@@ -24,15 +148,28 @@ void ppc::core::Perf::PipelineRun(const std::shared_ptr<PerfAttr>& perf_attr,
                                   const std::shared_ptr<ppc::core::PerfResults>& perf_results) const {
   perf_results->type_of_running = PerfResults::TypeOfRunning::kPipeline;
 
+  auto& stages = perf_results->stage_time_sec;
+  stages.fill(0.0);
+  const RunClock timer(perf_attr->current_timer);
   CommonRun(
-      perf_attr,
+      perf_attr, nullptr,
       [&]() {
+        const double t0 = timer();
         task_->Validation();
+        const double t1 = timer();
         task_->PreProcessing();
+        const double t2 = timer();
         task_->Run();
+        const double t3 = timer();
         task_->PostProcessing();
+        const double t4 = timer();
+        stages[PerfResults::kValidation] += t1 - t0;
+        stages[PerfResults::kPreProcessing] += t2 - t1;
+        stages[PerfResults::kRun] += t3 - t2;
+        stages[PerfResults::kPostProcessing] += t4 - t3;
       },
       perf_results);
+  FillRoofline(perf_attr, perf_results);
 }
 
 void ppc::core::Perf::TaskRun(const std::shared_ptr<PerfAttr>& perf_attr,
@@ -41,23 +178,244 @@ void ppc::core::Perf::TaskRun(const std::shared_ptr<PerfAttr>& perf_attr,
 
   task_->Validation();
   task_->PreProcessing();
-  CommonRun(perf_attr, [&]() { task_->Run(); }, perf_results);
+  CommonRun(perf_attr, [&]() { task_->ResetRunState(); }, [&]() { task_->Run(); }, perf_results);
+  perf_results->stage_time_sec.fill(0.0);
+  perf_results->stage_time_sec[PerfResults::kRun] = perf_results->time_sec;
+  FillRoofline(perf_attr, perf_results);
   task_->PostProcessing();
+  const auto repeated_outputs = CopyOutputs(perf_attr);
 
   task_->Validation();
   task_->PreProcessing();
   task_->Run();
   task_->PostProcessing();
+
+  // a single run on fresh state is the reference for the repeated ones
+  const auto single_outputs = CopyOutputs(perf_attr);
+  for (size_t i = 0; i < repeated_outputs.size(); i++) {
+    if (repeated_outputs[i] != single_outputs[i]) {
+      throw std::runtime_error("Output " + std::to_string(i) +
+                               " of repeated Run() calls differs from a single run: "
+                               "Task::ResetRunState() must restore the state Run() depends on");
+    }
+  }
+}
+
+std::vector<std::vector<uint8_t>> ppc::core::Perf::CopyOutputs(const std::shared_ptr<PerfAttr>& perf_attr) const {
+  std::vector<std::vector<uint8_t>> outputs;
+  if (!perf_attr->verify_runs) {
+    return outputs;
+  }
+  const auto& task_outputs = task_->GetData()->outputs;
+  if (perf_attr->output_bytes.empty() || perf_attr->output_bytes.size() > task_outputs.size()) {
+    throw std::invalid_argument("PerfAttr::verify_runs needs the byte size of every checked task output");
+  }
+  for (size_t i = 0; i < perf_attr->output_bytes.size(); i++) {
+    outputs.emplace_back(task_outputs[i], task_outputs[i] + perf_attr->output_bytes[i]);
+  }
+  return outputs;
+}
+
+void ppc::core::Perf::CommonRun(const std::shared_ptr<PerfAttr>& perf_attr, const std::function<void()>& prepare,
+                                const std::function<void()>& pipeline,
+                                const std::shared_ptr<ppc::core::PerfResults>& perf_results) const {
+  std::optional<ScopedThreadPin> pin;
+  if (perf_attr->pin_cpu >= 0) {
+    pin.emplace(perf_attr->pin_cpu);
+  }
+  perf_results->environment = CaptureEnvironment();
+  perf_results->environment.pinned_cpu = perf_attr->pin_cpu;
+  CheckNoise(perf_attr, perf_results->environment);
+
+  std::optional<TracingScope> tracing;
+  if (!perf_attr->trace_path.empty()) {
+    tracing.emplace();
+  }
+  std::optional<LoadBalanceScope> load_balance;
+  if (perf_attr->load_balance) {
+    load_balance.emplace();
+  }
+  std::optional<ProfilingScope> profiling;
+  if (!perf_attr->profile_path.empty()) {
+    profiling.emplace(perf_attr->profile_frequency_hz);
+  }
+
+  const auto& inputs_count = task_->GetData()->inputs_count;
+  perf_results->input_size = std::accumulate(inputs_count.begin(), inputs_count.end(), uint64_t{0});
+  perf_results->num_threads = ppc::util::GetPPCNumThreads();
+
+  auto& run_times = perf_results->run_time_sec;
+  run_times.clear();
+  if (perf_attr->cache_mode != PerfAttr::CacheMode::kCold) {
+    const RunClock clock(perf_attr->current_timer);
+    auto begin_all = clock();
+    for (uint64_t i = 0; i < perf_attr->num_running; i++) {
+      if (prepare) {
+        prepare();
+      }
+      if (perf_attr->sync_start) {
+        perf_attr->sync_start();
+      }
+      TraceSpan span("iteration", "perf");
+      auto begin = clock();
+      pipeline();
+      auto end = clock();
+      run_times.push_back(end - begin);
+    }
+    auto end_all = clock();
+    // preparation and synchronization between the runs are not timed
+    perf_results->time_sec = prepare || perf_attr->sync_start
+                                 ? std::accumulate(run_times.begin(), run_times.end(), 0.0)
+                                 : end_all - begin_all;
+  }
+
+  if (perf_attr->cache_mode != PerfAttr::CacheMode::kWarm) {
+    // the stages account the reported loop only, the warm one under kWarmAndCold
+    const auto warm_stage_times = perf_results->stage_time_sec;
+    std::vector<double> cold_run_times;
+    // TaskRun preprocesses once before all the runs, moved inputs would never be read
+    const bool relocate_inputs = perf_results->type_of_running == PerfResults::TypeOfRunning::kPipeline;
+    perf_results->cold_time_sec = ColdRun(perf_attr, prepare, pipeline, relocate_inputs, cold_run_times);
+    if (perf_attr->cache_mode == PerfAttr::CacheMode::kCold) {
+      perf_results->time_sec = perf_results->cold_time_sec;
+      run_times = std::move(cold_run_times);
+    } else {
+      perf_results->stage_time_sec = warm_stage_times;
+    }
+  }
+
+  if (load_balance) {
+    load_balance.reset();
+    perf_results->load_balance = LoadBalance::Summarize();
+    LoadBalance::Clear();
+  }
+  if (profiling) {
+    profiling.reset();
+    SamplingProfiler::WriteFolded(perf_attr->profile_path);
+  }
+  if (tracing) {
+    tracing.reset();
+    Trace::WriteChromeTrace(perf_attr->trace_path);
+  }
 }
 
-void ppc::core::Perf::CommonRun(const std::shared_ptr<PerfAttr>& perf_attr, const std::function<void()>& pipeline,
-                                const std::shared_ptr<ppc::core::PerfResults>& perf_results) {
-  auto begin = perf_attr->current_timer();
+double ppc::core::Perf::ColdRun(const std::shared_ptr<PerfAttr>& perf_attr, const std::function<void()>& prepare,
+                                const std::function<void()>& pipeline, bool relocate_inputs,
+                                std::vector<double>& run_times) const {
+  CacheFlusher flusher(perf_attr->cache_flush_bytes);
+  std::optional<InputRelocator> relocator;
+  if (relocate_inputs) {
+    relocator.emplace(*task_->GetData(), perf_attr->input_bytes);
+  }
+
+  const RunClock clock(perf_attr->current_timer);
+  double total = 0.0;
   for (uint64_t i = 0; i < perf_attr->num_running; i++) {
+    if (relocator) {
+      relocator->Relocate();
+    }
+    if (prepare) {
+      prepare();
+    }
+    flusher.Flush();
+    if (perf_attr->sync_start) {
+      perf_attr->sync_start();
+    }
+
+    TraceSpan span("cold_iteration", "perf");
+    auto begin = clock();
     pipeline();
+    auto end = clock();
+    run_times.push_back(end - begin);
+    total += end - begin;
+  }
+  return total;
+}
+
+void ppc::core::Perf::CheckNoise(const std::shared_ptr<PerfAttr>& perf_attr, const EnvironmentSnapshot& environment) {
+  if (perf_attr->noise_policy == PerfAttr::NoisePolicy::kIgnore) {
+    return;
+  }
+  const auto warnings = NoiseWarnings(environment, perf_attr->noise_limits);
+  if (warnings.empty()) {
+    return;
+  }
+  std::stringstream message;
+  message << "Noisy benchmark environment (" << environment.ToString() << "):";
+  for (const auto& warning : warnings) {
+    message << "\n  " << warning;
+  }
+  if (perf_attr->noise_policy == PerfAttr::NoisePolicy::kRefuse) {
+    throw std::runtime_error(message.str());
+  }
+  std::cerr << message.str() << '\n';
+}
+
+void ppc::core::Perf::FillRoofline(const std::shared_ptr<PerfAttr>& perf_attr,
+                                   const std::shared_ptr<PerfResults>& perf_results) const {
+  const double runs = static_cast<double>(perf_attr->num_running);
+  // the declared work is done by Run() alone, the other pipeline stages would dilute the rates
+  const double run_sec = perf_results->stage_time_sec[PerfResults::kRun];
+  if (run_sec > 0.0) {
+    perf_results->gflops = task_->GetFlopsPerRun() * runs / run_sec * 1e-9;
+    perf_results->bandwidth_gbs = task_->GetBytesPerRun() * runs / run_sec * 1e-9;
+  }
+  if (perf_attr->roofline) {
+    const MachinePeaks peaks = GetMachinePeaks(ppc::util::GetPPCNumThreads());
+    perf_results->peak_gflops = peaks.gflops;
+    perf_results->peak_bandwidth_gbs = peaks.bandwidth_gbs;
+  }
+}
+
+void ppc::core::Perf::PrintRoofline(const std::string& prefix, const std::shared_ptr<PerfResults>& perf_results) {
+  const auto& res = *perf_results;
+  if (res.gflops <= 0.0 && res.bandwidth_gbs <= 0.0) {
+    return;
+  }
+  // formatted apart, so that the flags of std::cout stay untouched
+  std::stringstream line;
+  line << prefix << ":roofline:" << std::fixed << std::setprecision(3) << "gflops=" << res.gflops
+       << " gbs=" << res.bandwidth_gbs;
+  if (res.peak_gflops > 0.0 && res.peak_bandwidth_gbs > 0.0) {
+    // arithmetic intensity of the kernel vs. the machine balance point (FLOP/byte)
+    const double intensity = res.bandwidth_gbs > 0.0 ? res.gflops / res.bandwidth_gbs : 0.0;
+    const double ridge = res.peak_gflops / res.peak_bandwidth_gbs;
+    const bool memory_bound = intensity < ridge;
+    const double of_roof =
+        memory_bound ? res.bandwidth_gbs / res.peak_bandwidth_gbs : res.gflops / res.peak_gflops;
+    line << " peak_gflops=" << res.peak_gflops << " peak_gbs=" << res.peak_bandwidth_gbs << " intensity=" << intensity
+         << " ridge=" << ridge << (memory_bound ? " memory-bound" : " compute-bound") << std::setprecision(1)
+         << " of_roof=" << 100.0 * of_roof << "%";
+  }
+  std::cout << line.str() << '\n';
+}
+
+void ppc::core::Perf::PrintLoadBalance(const std::string& prefix,
+                                       const std::shared_ptr<PerfResults>& perf_results) {
+  const auto& summary = perf_results->load_balance;
+  if (summary.regions == 0) {
+    return;
+  }
+  std::stringstream line;
+  line << prefix << ":load_balance:regions=" << summary.regions << std::fixed << std::setprecision(3)
+       << " imbalance=" << summary.imbalance << " worst=" << summary.worst_imbalance << std::setprecision(1)
+       << " idle=" << 100.0 * summary.idle_fraction << "%";
+  std::cout << line.str() << '\n';
+}
+
+void ppc::core::Perf::PrintSamples(const std::string& prefix, const std::shared_ptr<PerfResults>& perf_results) {
+  const auto& res = *perf_results;
+  if (res.run_time_sec.empty()) {
+    return;
+  }
+  // consumed by scripts/perf_baseline.py
+  std::stringstream line;
+  line << prefix << ":samples:size=" << res.input_size << " threads=" << res.num_threads
+       << " procs=" << res.num_processes << " runs=" << std::scientific << std::setprecision(9);
+  for (size_t i = 0; i < res.run_time_sec.size(); i++) {
+    line << (i == 0 ? "" : ",") << res.run_time_sec[i];
   }
-  auto end = perf_attr->current_timer();
-  perf_results->time_sec = end - begin;
+  std::cout << line.str() << '\n';
 }
 
 void ppc::core::Perf::PrintPerfStatistic(const std::shared_ptr<PerfResults>& perf_results) {
@@ -86,6 +444,20 @@ void ppc::core::Perf::PrintPerfStatistic(const std::shared_ptr<PerfResults>& per
   if (time_secs < PerfResults::kMaxTime) {
     perf_res_str << std::fixed << std::setprecision(10) << time_secs;
     std::cout << relative_path << ":" << type_test_name << ":" << perf_res_str.str() << '\n';
+    if (perf_results->cold_time_sec > 0.0 && perf_results->cold_time_sec != time_secs) {
+      std::stringstream cache_str;
+      const double cold_secs = perf_results->cold_time_sec;
+      cache_str << std::fixed << std::setprecision(10) << "warm=" << time_secs << " cold=" << cold_secs
+                << std::setprecision(2) << " cold/warm=" << (time_secs > 0.0 ? cold_secs / time_secs : 0.0);
+      std::cout << relative_path << ":" << type_test_name << ":cache:" << cache_str.str() << '\n';
+    }
+    PrintRoofline(relative_path + ":" + type_test_name, perf_results);
+    PrintLoadBalance(relative_path + ":" + type_test_name, perf_results);
+    PrintSamples(relative_path + ":" + type_test_name, perf_results);
+    if (perf_results->environment.online_cpus > 0) {
+      std::cout << relative_path << ":" << type_test_name << ":environment:" << perf_results->environment.ToString()
+                << '\n';
+    }
   } else {
     std::stringstream err_msg;
     err_msg << '\n' << "Task execute time need to be: ";
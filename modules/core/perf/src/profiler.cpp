@@ -0,0 +1,201 @@
+#include "core/perf/include/profiler.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define PPC_SAMPLING_PROFILER 1
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <sys/time.h>
+
+#include <csignal>
+#include <cstdlib>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+using ppc::core::SamplingProfiler;
+
+struct StackSample {
+  std::array<void *, SamplingProfiler::kMaxDepth> frames{};
+  std::atomic<int> depth{0};
+};
+
+// Everything the signal handler touches is allocated before the timer starts
+struct ProfilerState {
+  std::vector<StackSample> samples = std::vector<StackSample>(SamplingProfiler::kMaxSamples);
+  std::atomic<size_t> next{0};
+  std::atomic<size_t> dropped{0};
+  std::atomic<bool> running{false};
+#ifdef PPC_SAMPLING_PROFILER
+  struct sigaction previous_action {};
+#endif
+};
+
+ProfilerState &State() {
+  static ProfilerState state;
+  return state;
+}
+
+#ifdef PPC_SAMPLING_PROFILER
+// the handler itself and the signal trampoline
+constexpr int kSkippedFrames = 2;
+
+void OnProfilingSignal(int /*signal*/) {
+  const int saved_errno = errno;
+  auto &state = State();
+  const size_t index = state.next.fetch_add(1, std::memory_order_relaxed);
+  if (index < state.samples.size()) {
+    auto &sample = state.samples[index];
+    sample.depth.store(backtrace(sample.frames.data(), SamplingProfiler::kMaxDepth), std::memory_order_release);
+  } else {
+    state.dropped.fetch_add(1, std::memory_order_relaxed);
+  }
+  errno = saved_errno;
+}
+
+std::string Symbolize(void *address, std::map<void *, std::string> &cache) {
+  const auto it = cache.find(address);
+  if (it != cache.end()) {
+    return it->second;
+  }
+  std::string name;
+  Dl_info info{};
+  if (dladdr(address, &info) != 0 && info.dli_sname != nullptr) {
+    int status = 0;
+    char *demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+    name = status == 0 && demangled != nullptr ? demangled : info.dli_sname;
+    std::free(demangled);  // NOLINT(cppcoreguidelines-no-malloc)
+  } else if (info.dli_fname != nullptr) {
+    std::string module(info.dli_fname);
+    module = module.substr(module.find_last_of('/') + 1);
+    std::stringstream frame;
+    frame << module << "+0x" << std::hex
+          << (reinterpret_cast<uintptr_t>(address) - reinterpret_cast<uintptr_t>(info.dli_fbase));
+    name = frame.str();
+  } else {
+    std::stringstream frame;
+    frame << address;
+    name = frame.str();
+  }
+  // ';' separates frames and the last space separates the count in folded stacks
+  std::ranges::replace(name, ';', ':');
+  std::ranges::replace(name, ' ', '_');
+  return cache[address] = name;
+}
+#endif
+
+}  // namespace
+
+void ppc::core::SamplingProfiler::Start(int frequency_hz) {
+#ifdef PPC_SAMPLING_PROFILER
+  auto &state = State();
+  if (state.running.load()) {
+    throw std::runtime_error("SamplingProfiler is already running");
+  }
+  if (frequency_hz <= 0 || frequency_hz > 1000000) {
+    throw std::invalid_argument("SamplingProfiler frequency must be in (0, 1e6] Hz");
+  }
+  for (auto &sample : state.samples) {
+    sample.depth.store(0, std::memory_order_relaxed);
+  }
+  state.next.store(0);
+  state.dropped.store(0);
+
+  // the first backtrace() call loads the unwinder, which must not happen inside the handler
+  std::array<void *, 1> warm_up{};
+  backtrace(warm_up.data(), static_cast<int>(warm_up.size()));
+
+  struct sigaction action {};
+  action.sa_handler = OnProfilingSignal;
+  sigemptyset(&action.sa_mask);
+  action.sa_flags = SA_RESTART;
+  if (sigaction(SIGPROF, &action, &state.previous_action) != 0) {
+    throw std::runtime_error("Can't install the SIGPROF handler");
+  }
+  itimerval timer{};
+  // tv_usec must stay below one second, 1 Hz is a whole second
+  const int interval_usec = 1000000 / frequency_hz;
+  timer.it_interval.tv_sec = interval_usec / 1000000;
+  timer.it_interval.tv_usec = interval_usec % 1000000;
+  timer.it_value = timer.it_interval;
+  state.running.store(true);
+  if (setitimer(ITIMER_PROF, &timer, nullptr) != 0) {
+    state.running.store(false);
+    sigaction(SIGPROF, &state.previous_action, nullptr);
+    throw std::runtime_error("Can't start the profiling timer");
+  }
+#else
+  (void)frequency_hz;
+  throw std::runtime_error("SamplingProfiler is not supported on this platform");
+#endif
+}
+
+void ppc::core::SamplingProfiler::Stop() {
+#ifdef PPC_SAMPLING_PROFILER
+  auto &state = State();
+  if (!state.running.exchange(false)) {
+    return;
+  }
+  itimerval timer{};
+  setitimer(ITIMER_PROF, &timer, nullptr);
+  sigaction(SIGPROF, &state.previous_action, nullptr);
+#endif
+}
+
+bool ppc::core::SamplingProfiler::IsRunning() { return State().running.load(); }
+
+size_t ppc::core::SamplingProfiler::SampleCount() {
+  return std::min(State().next.load(), State().samples.size());
+}
+
+size_t ppc::core::SamplingProfiler::DroppedCount() { return State().dropped.load(); }
+
+void ppc::core::SamplingProfiler::WriteFolded(std::ostream &out) {
+#ifdef PPC_SAMPLING_PROFILER
+  auto &state = State();
+  std::map<void *, std::string> names;
+  std::map<std::string, size_t> stacks;
+  for (size_t i = 0; i < SampleCount(); i++) {
+    const auto &sample = state.samples[i];
+    const int depth = sample.depth.load(std::memory_order_acquire);
+    if (depth <= kSkippedFrames) {
+      continue;
+    }
+    std::string stack;
+    for (int frame = depth - 1; frame >= kSkippedFrames; frame--) {
+      if (!stack.empty()) {
+        stack += ';';
+      }
+      stack += Symbolize(sample.frames[frame], names);
+    }
+    stacks[stack]++;
+  }
+  for (const auto &[stack, count] : stacks) {
+    out << stack << ' ' << count << '\n';
+  }
+#else
+  (void)out;
+#endif
+}
+
+void ppc::core::SamplingProfiler::WriteFolded(const std::string &path) {
+  std::ofstream file(path);
+  if (!file.is_open()) {
+    throw std::runtime_error("Can't open profile file: " + path);
+  }
+  WriteFolded(file);
+}
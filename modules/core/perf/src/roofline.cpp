@@ -0,0 +1,172 @@
+#include "core/perf/include/roofline.hpp"
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <barrier>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/util/include/cpu_dispatch.hpp"
+#include "core/util/include/kernels.hpp"
+#include "core/util/include/util.hpp"
+
+namespace {
+
+constexpr size_t kMinStreamBytes = size_t{48} << 20;
+constexpr size_t kMaxStreamBytes = size_t{384} << 20;
+constexpr int kRepeats = 5;
+// rounds of the multiply-add chains per thread
+constexpr int64_t kChainIterations = int64_t{1} << 22;
+
+// Runs `body(thread_id)` on `num_threads` threads and returns the best
+// wall time of the section between the two barrier phases of every repeat
+template <class Body>
+double BestSectionTime(int num_threads, Body body) {
+  std::barrier sync(num_threads);
+  double best = std::numeric_limits<double>::max();
+  auto worker = [&](int id) {
+    for (int rep = 0; rep < kRepeats; rep++) {
+      sync.arrive_and_wait();
+      const auto begin = std::chrono::steady_clock::now();
+      body(id);
+      sync.arrive_and_wait();
+      if (id == 0) {
+        best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count());
+      }
+    }
+  };
+  std::vector<std::thread> threads;
+  for (int id = 1; id < num_threads; id++) {
+    threads.emplace_back(worker, id);
+  }
+  worker(0);
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  return best;
+}
+
+double MeasureBandwidth(int num_threads, size_t stream_bytes) {
+  const size_t per_thread = stream_bytes / (3 * sizeof(double) * static_cast<size_t>(num_threads));
+  std::vector<std::vector<double>> a(num_threads);
+  std::vector<std::vector<double>> b(num_threads);
+  std::vector<std::vector<double>> c(num_threads);
+  const double scalar = 3.0;
+
+  const double time = BestSectionTime(num_threads, [&](int id) {
+    if (a[id].empty()) {
+      // the first repeat places pages near the thread that streams them
+      a[id].assign(per_thread, 0.0);
+      b[id].assign(per_thread, 1.0);
+      c[id].assign(per_thread, 2.0);
+    }
+    double *pa = a[id].data();
+    const double *pb = b[id].data();
+    const double *pc = c[id].data();
+    for (size_t i = 0; i < per_thread; i++) {
+      pa[i] = pb[i] + (scalar * pc[i]);
+    }
+  });
+
+  const double bytes = 3.0 * sizeof(double) * static_cast<double>(per_thread) * num_threads;
+  return bytes / time * 1e-9;
+}
+
+// the multiply-add probe of the level kernels dispatch to, so that the roof
+// bounds what the dispatched kernels can reach
+double MeasureFlops(int num_threads) {
+  std::vector<double> sinks(num_threads, 0.0);
+  std::vector<double> flops(num_threads, 0.0);
+  const double time =
+      BestSectionTime(num_threads, [&](int id) { flops[id] = ppc::util::FmaPeak(kChainIterations, sinks[id]); });
+
+  volatile double sink = 0.0;
+  for (double value : sinks) {
+    sink = sink + value;
+  }
+  double total = 0.0;
+  for (double value : flops) {
+    total += value;
+  }
+  return total / time * 1e-9;
+}
+
+std::string GetHostName() {
+#ifdef _WIN32
+  size_t len;
+  char host[256];
+  if (getenv_s(&len, host, sizeof(host), "COMPUTERNAME") != 0 || len == 0) {
+    return "localhost";
+  }
+  return host;
+#else
+  std::array<char, 256> host{};
+  if (gethostname(host.data(), host.size() - 1) != 0) {
+    return "localhost";
+  }
+  return host.data();
+#endif
+}
+
+}  // namespace
+
+ppc::core::MachinePeaks ppc::core::MeasureMachinePeaks(int num_threads, size_t stream_bytes) {
+  num_threads = std::max(num_threads, 1);
+  if (stream_bytes == 0) {
+    // STREAM rule of thumb: the arrays must be several times larger than the caches
+    stream_bytes = std::clamp(4 * ppc::util::GetLastLevelCacheSize(), kMinStreamBytes, kMaxStreamBytes);
+  }
+  MachinePeaks peaks;
+  peaks.bandwidth_gbs = MeasureBandwidth(num_threads, stream_bytes);
+  peaks.gflops = MeasureFlops(num_threads);
+  return peaks;
+}
+
+std::string ppc::core::GetMachinePeaksCachePath() {
+  std::string env_dir;
+#ifdef _WIN32
+  size_t len;
+  char env_buf[1024];
+  if (getenv_s(&len, env_buf, sizeof(env_buf), "PPC_PERF_CACHE_DIR") == 0 && len != 0) {
+    env_dir = env_buf;
+  }
+#else
+  if (const char *env_ptr = std::getenv("PPC_PERF_CACHE_DIR")) {
+    env_dir = env_ptr;
+  }
+#endif
+  const std::filesystem::path dir =
+      env_dir.empty() ? std::filesystem::temp_directory_path() : std::filesystem::path(env_dir);
+  const std::string isa = ppc::util::IsaName(ppc::util::GetIsaLevel());
+  return (dir / ("ppc_machine_peaks_" + GetHostName() + "_" + isa + ".txt")).string();
+}
+
+ppc::core::MachinePeaks ppc::core::GetMachinePeaks(int num_threads) {
+  const std::string path = GetMachinePeaksCachePath();
+  {
+    // one line per measured thread count: <threads> <bandwidth_gbs> <gflops>
+    std::ifstream cache(path);
+    int threads = 0;
+    MachinePeaks peaks;
+    while (cache >> threads >> peaks.bandwidth_gbs >> peaks.gflops) {
+      if (threads == num_threads) {
+        return peaks;
+      }
+    }
+  }
+  const MachinePeaks peaks = MeasureMachinePeaks(num_threads);
+  std::ofstream(path, std::ios::app) << num_threads << ' ' << peaks.bandwidth_gbs << ' ' << peaks.gflops << '\n';
+  return peaks;
+}
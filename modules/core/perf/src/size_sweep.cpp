@@ -0,0 +1,169 @@
+#include "core/perf/include/size_sweep.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core/task/include/task.hpp"
+#include "core/util/include/util.hpp"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+std::map<std::string, ppc::core::InputGenerator> &Generators() {
+  static std::map<std::string, ppc::core::InputGenerator> generators;
+  return generators;
+}
+
+std::vector<uint64_t> GeometricSizes(const ppc::core::SizeSweepAttr &attr) {
+  if (attr.min_n == 0 || attr.max_n < attr.min_n || attr.factor <= 1.0) {
+    throw std::invalid_argument("SizeSweepAttr: need 0 < min_n <= max_n and factor > 1");
+  }
+  std::vector<uint64_t> sizes;
+  for (double n = static_cast<double>(attr.min_n); n <= static_cast<double>(attr.max_n); n *= attr.factor) {
+    const auto size = static_cast<uint64_t>(std::llround(n));
+    if (sizes.empty() || size != sizes.back()) {
+      sizes.push_back(size);
+    }
+  }
+  return sizes;
+}
+
+ppc::core::SizePoint MeasureSize(const ppc::core::InputGenerator &generator, uint64_t n,
+                                 const ppc::core::SizeSweepAttr &attr) {
+  const ppc::core::SizedTask sized = generator(n);
+  auto &task = *sized.task;
+  task.GetData()->state_of_testing = ppc::core::TaskData::StateOfTesting::kPerf;
+  if (!task.Validation()) {
+    throw std::invalid_argument("Input generator produced invalid data for n = " + std::to_string(n));
+  }
+  task.PreProcessing();
+
+  double best = std::numeric_limits<double>::max();
+  double total = 0.0;
+  for (uint64_t run = 0; run < attr.min_runs || total < attr.min_time_sec; run++) {
+    task.ResetRunState();
+    const auto begin = Clock::now();
+    task.Run();
+    const double time = std::chrono::duration<double>(Clock::now() - begin).count();
+    best = std::min(best, time);
+    total += time;
+  }
+
+  ppc::core::SizePoint point;
+  point.n = n;
+  point.time_sec = best;
+  const double work = task.GetFlopsPerRun() > 0.0 ? task.GetFlopsPerRun() : static_cast<double>(n);
+  point.throughput = best > 0.0 ? work / best : 0.0;
+  point.working_set_bytes = task.GetBytesPerRun();
+  task.PostProcessing();
+  return point;
+}
+
+std::string MemoryLevel(double bytes) {
+  const auto l2 = static_cast<double>(ppc::util::GetCacheSize(2));
+  const auto llc = static_cast<double>(ppc::util::GetLastLevelCacheSize());
+  if (bytes <= 0.0 || llc <= 0.0) {
+    return "";
+  }
+  if (l2 > 0.0 && bytes <= l2) {
+    return "L2";
+  }
+  return bytes <= llc ? "LLC" : "DRAM";
+}
+
+// Least squares fit of log(time) = log(c) + k * log(n)
+ppc::core::ComplexityBand FitBand(const std::vector<ppc::core::SizePoint> &points, size_t first, size_t last) {
+  ppc::core::ComplexityBand band{.first = first, .last = last};
+  const auto count = static_cast<double>(last - first + 1);
+  double sx = 0.0;
+  double sy = 0.0;
+  double sxx = 0.0;
+  double sxy = 0.0;
+  for (size_t i = first; i <= last; i++) {
+    const double x = std::log(static_cast<double>(points[i].n));
+    const double y = std::log(std::max(points[i].time_sec, 1e-12));
+    sx += x;
+    sy += y;
+    sxx += x * x;
+    sxy += x * y;
+  }
+  const double denominator = (count * sxx) - (sx * sx);
+  band.k = denominator > 0.0 ? ((count * sxy) - (sx * sy)) / denominator : 0.0;
+  band.c = std::exp((sy - (band.k * sx)) / count);
+  return band;
+}
+
+}  // namespace
+
+void ppc::core::RegisterInputGenerator(const std::string &name, InputGenerator generator) {
+  Generators()[name] = std::move(generator);
+}
+
+const ppc::core::InputGenerator &ppc::core::GetInputGenerator(const std::string &name) {
+  const auto it = Generators().find(name);
+  if (it == Generators().end()) {
+    throw std::invalid_argument("No input generator registered for " + name);
+  }
+  return it->second;
+}
+
+ppc::core::SizeSweepResults ppc::core::MeasureSizeSweep(const InputGenerator &generator, const SizeSweepAttr &attr) {
+  SizeSweepResults results;
+  for (uint64_t n : GeometricSizes(attr)) {
+    results.points.push_back(MeasureSize(generator, n, attr));
+    auto &point = results.points.back();
+    point.level = MemoryLevel(point.working_set_bytes);
+    if (results.points.size() > 1) {
+      const auto &previous = results.points[results.points.size() - 2];
+      point.throughput_drop = point.throughput < (1.0 - attr.drop_threshold) * previous.throughput;
+    }
+  }
+
+  size_t first = 0;
+  for (size_t i = 1; i <= results.points.size(); i++) {
+    const bool split = i == results.points.size() || results.points[i].throughput_drop ||
+                       results.points[i].level != results.points[i - 1].level;
+    if (split) {
+      results.bands.push_back(FitBand(results.points, first, i - 1));
+      first = i;
+    }
+  }
+  return results;
+}
+
+void ppc::core::PrintSizeSweep(const std::string &name, const SizeSweepResults &results) {
+  // formatted apart, so that the flags of std::cout stay untouched
+  std::stringstream out;
+  for (const auto &point : results.points) {
+    out << name << ":sweep:n=" << point.n << std::scientific << std::setprecision(4) << " time=" << point.time_sec
+        << " throughput=" << point.throughput;
+    if (!point.level.empty()) {
+      out << " working_set=" << point.working_set_bytes << " level=" << point.level;
+    }
+    out << (point.throughput_drop ? " throughput-drop" : "") << '\n';
+  }
+  for (const auto &band : results.bands) {
+    out << name << ":sweep:band n=" << results.points[band.first].n << ".." << results.points[band.last].n;
+    if (band.first == band.last) {
+      // a single size does not determine the exponent
+      out << " single size\n";
+      continue;
+    }
+    out << std::scientific << std::setprecision(4) << " time=" << band.c << "*n^" << std::fixed << std::setprecision(3)
+        << band.k << '\n';
+  }
+  std::cout << out.str();
+}
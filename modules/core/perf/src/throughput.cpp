@@ -0,0 +1,121 @@
+#include "core/perf/include/throughput.hpp"
+
+#include <algorithm>
+#include <barrier>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "core/task/include/task.hpp"
+#include "core/util/include/thread_pool.hpp"
+#include "core/util/include/util.hpp"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+std::vector<int> ConcurrencySweep(int max_concurrency) {
+  std::vector<int> sweep;
+  for (int k = 1; k < max_concurrency; k *= 2) {
+    sweep.push_back(k);
+  }
+  sweep.push_back(max_concurrency);
+  return sweep;
+}
+
+// Runs the first `concurrency` copies as jobs of `pool`, which has at least as
+// many threads, so that every copy gets a thread of its own
+ppc::core::ThroughputPoint MeasurePoint(ppc::util::ThreadPool &pool,
+                                        const std::vector<std::shared_ptr<ppc::core::Task>> &copies, int concurrency,
+                                        uint64_t runs_per_copy) {
+  std::vector<std::vector<double>> latencies(concurrency, std::vector<double>(runs_per_copy));
+  std::vector<Clock::time_point> begins(concurrency);
+  std::vector<Clock::time_point> ends(concurrency);
+  std::barrier sync(concurrency);
+
+  for (int id = 0; id < concurrency; id++) {
+    pool.Submit([&, id] {
+      auto &task = *copies[id];
+      // waking the pool threads is not part of the measurement
+      sync.arrive_and_wait();
+      begins[id] = Clock::now();
+      for (uint64_t run = 0; run < runs_per_copy; run++) {
+        const auto begin = Clock::now();
+        task.Validation();
+        task.PreProcessing();
+        task.Run();
+        task.PostProcessing();
+        latencies[id][run] = std::chrono::duration<double>(Clock::now() - begin).count();
+      }
+      ends[id] = Clock::now();
+    });
+  }
+  pool.Wait();
+
+  std::vector<double> all;
+  for (const auto &copy_latencies : latencies) {
+    all.insert(all.end(), copy_latencies.begin(), copy_latencies.end());
+  }
+  std::ranges::sort(all);
+  double sum = 0.0;
+  for (double latency : all) {
+    sum += latency;
+  }
+
+  ppc::core::ThroughputPoint point;
+  point.concurrency = concurrency;
+  point.wall_sec =
+      std::chrono::duration<double>(*std::ranges::max_element(ends) - *std::ranges::min_element(begins)).count();
+  point.tasks_per_sec = point.wall_sec > 0.0 ? static_cast<double>(all.size()) / point.wall_sec : 0.0;
+  point.latency_avg_sec = sum / static_cast<double>(all.size());
+  point.latency_p50_sec = all[all.size() / 2];
+  point.latency_max_sec = all.back();
+  return point;
+}
+
+}  // namespace
+
+std::vector<ppc::core::ThroughputPoint> ppc::core::MeasureThroughput(const TaskFactory &factory,
+                                                                     const ThroughputAttr &attr) {
+  if (attr.runs_per_copy == 0) {
+    throw std::invalid_argument("ThroughputAttr::runs_per_copy must be positive");
+  }
+  const int max_concurrency = attr.max_concurrency > 0 ? attr.max_concurrency : ppc::util::GetUsableCpuCount();
+
+  std::vector<std::shared_ptr<Task>> copies;
+  for (int copy = 0; copy < max_concurrency; copy++) {
+    copies.push_back(factory(copy));
+    copies.back()->GetData()->state_of_testing = TaskData::StateOfTesting::kPerf;
+  }
+
+  // one pool for the whole sweep: the global one may have fewer threads than
+  // copies, and a copy waiting for a thread would never pass the start barrier
+  ppc::util::ThreadPool pool(max_concurrency);
+  std::vector<ThroughputPoint> points;
+  for (int concurrency : ConcurrencySweep(max_concurrency)) {
+    points.push_back(MeasurePoint(pool, copies, concurrency, attr.runs_per_copy));
+  }
+  const double single_rate = points.front().tasks_per_sec;
+  for (auto &point : points) {
+    point.scaling = single_rate > 0.0 ? point.tasks_per_sec / (single_rate * point.concurrency) : 0.0;
+  }
+  return points;
+}
+
+void ppc::core::PrintThroughput(const std::string &name, const std::vector<ThroughputPoint> &points) {
+  for (const auto &point : points) {
+    std::stringstream line;
+    line << name << ":throughput:k=" << point.concurrency << std::fixed << std::setprecision(3)
+         << " tasks/s=" << point.tasks_per_sec << std::setprecision(10) << " latency_avg=" << point.latency_avg_sec
+         << " latency_p50=" << point.latency_p50_sec << " latency_max=" << point.latency_max_sec
+         << std::setprecision(3) << " scaling=" << point.scaling;
+    std::cout << line.str() << '\n';
+  }
+}
@@ -42,6 +42,16 @@ class Task {
   // get input and output data
   [[nodiscard]] TaskDataPtr GetData() const;
 
+  // amount of work of one Run() call for roofline reports (0 - not declared):
+  // arithmetic operations and bytes read/written from/to memory
+  [[nodiscard]] virtual double GetFlopsPerRun() const;
+  [[nodiscard]] virtual double GetBytesPerRun() const;
+
+  // restore the state Run() updates (e.g. accumulators) so that Run() can be
+  // repeated on the same pre-processed data; Perf calls it outside the timed
+  // region before every measured Run() of TaskRun
+  virtual void ResetRunState();
+
   virtual ~Task();
 
  protected:
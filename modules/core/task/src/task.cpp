@@ -7,6 +7,8 @@
 #include <stdexcept>
 #include <string>
 
+#include "core/trace/include/trace.hpp"
+
 void ppc::core::Task::SetData(TaskDataPtr task_data_ptr) {
   task_data_ptr->state_of_testing = TaskData::StateOfTesting::kFunc;
   functions_order_.clear();
@@ -15,25 +17,35 @@ void ppc::core::Task::SetData(TaskDataPtr task_data_ptr) {
 
 ppc::core::TaskDataPtr ppc::core::Task::GetData() const { return task_data; }
 
+double ppc::core::Task::GetFlopsPerRun() const { return 0.0; }
+
+double ppc::core::Task::GetBytesPerRun() const { return 0.0; }
+
+void ppc::core::Task::ResetRunState() {}
+
 ppc::core::Task::Task(TaskDataPtr task_data) { SetData(std::move(task_data)); }
 
 bool ppc::core::Task::Validation() {
   InternalOrderTest();
+  TraceSpan span("Validation", "task");
   return ValidationImpl();
 }
 
 bool ppc::core::Task::PreProcessing() {
   InternalOrderTest();
+  TraceSpan span("PreProcessing", "task");
   return PreProcessingImpl();
 }
 
 bool ppc::core::Task::Run() {
   InternalOrderTest();
+  TraceSpan span("Run", "task");
   return RunImpl();
 }
 
 bool ppc::core::Task::PostProcessing() {
   InternalOrderTest();
+  TraceSpan span("PostProcessing", "task");
   return PostProcessingImpl();
 }
 
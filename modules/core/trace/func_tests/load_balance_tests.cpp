@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "core/trace/include/load_balance.hpp"
+
+TEST(load_balance_tests, check_disabled_region_records_nothing) {
+  ppc::core::LoadBalance::Disable();
+  ppc::core::LoadBalance::Clear();
+  {
+    ppc::core::ParallelRegion region("region", 2);
+    EXPECT_FALSE(region.IsActive());
+    ppc::core::WorkerScope scope(region, 0, 10);
+  }
+  EXPECT_TRUE(ppc::core::LoadBalance::Regions().empty());
+  EXPECT_EQ(ppc::core::LoadBalance::Summarize().regions, 0U);
+}
+
+TEST(load_balance_tests, check_uneven_workers) {
+  constexpr int kWorkers = 2;
+
+  ppc::core::LoadBalance::Clear();
+  ppc::core::LoadBalance::Enable();
+  {
+    ppc::core::ParallelRegion region("uneven", kWorkers);
+    std::vector<std::thread> threads;
+    for (int id = 0; id < kWorkers; id++) {
+      threads.emplace_back([&region, id] {
+        // worker 1 gets three times the work of worker 0
+        ppc::core::WorkerScope scope(region, id, 10 * (1 + (2 * id)));
+        std::this_thread::sleep_for(std::chrono::milliseconds(20 * (1 + (2 * id))));
+      });
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+  }
+  ppc::core::LoadBalance::Disable();
+
+  const auto regions = ppc::core::LoadBalance::Regions();
+  ASSERT_EQ(regions.size(), 1U);
+  EXPECT_EQ(regions[0].items, (std::vector<uint64_t>{10, 30}));
+  EXPECT_GT(regions[0].busy_ns[1], regions[0].busy_ns[0]);
+  // max/mean = 3 / 2 and worker 0 idles for about 2/3 of the region
+  EXPECT_NEAR(regions[0].Imbalance(), 1.5, 0.2);
+  EXPECT_NEAR(regions[0].IdleFraction(), 1.0 / 3.0, 0.1);
+
+  const auto summary = ppc::core::LoadBalance::Summarize();
+  EXPECT_EQ(summary.regions, 1U);
+  EXPECT_DOUBLE_EQ(summary.imbalance, regions[0].Imbalance());
+  EXPECT_DOUBLE_EQ(summary.worst_imbalance, regions[0].Imbalance());
+  ppc::core::LoadBalance::Clear();
+}
@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/task/func_tests/test_task.hpp"
+#include "core/task/include/task.hpp"
+#include "core/trace/include/trace.hpp"
+
+TEST(trace_tests, check_disabled_trace_records_nothing) {
+  ppc::core::Trace::Disable();
+  ppc::core::Trace::Clear();
+  {
+    ppc::core::TraceSpan span("region");
+  }
+  EXPECT_EQ(ppc::core::Trace::EventCount(), 0U);
+}
+
+TEST(trace_tests, check_spans_from_threads) {
+  constexpr int kThreads = 4;
+  constexpr int kSpans = 3000;
+
+  ppc::core::Trace::Clear();
+  ppc::core::Trace::Enable();
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; t++) {
+    threads.emplace_back([] {
+      for (int i = 0; i < kSpans; i++) {
+        ppc::core::TraceSpan span("worker", "thread");
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  ppc::core::Trace::Disable();
+
+  EXPECT_EQ(ppc::core::Trace::EventCount(), static_cast<size_t>(kThreads * kSpans));
+  ppc::core::Trace::Clear();
+  EXPECT_EQ(ppc::core::Trace::EventCount(), 0U);
+}
+
+TEST(trace_tests, check_exited_thread_buffers_are_reused) {
+  // the "tid" of the only span of a short-lived thread
+  auto span_tid = [] {
+    std::thread([] { ppc::core::TraceSpan span("short_lived", "thread"); }).join();
+    std::stringstream trace;
+    ppc::core::Trace::WriteChromeTrace(trace);
+    const std::string json = trace.str();
+    const auto pos = json.find("\"tid\":");
+    EXPECT_NE(pos, std::string::npos);
+    EXPECT_EQ(json.find("\"tid\":", pos + 1), std::string::npos);
+    return std::stoi(json.substr(pos + 6));
+  };
+
+  ppc::core::Trace::Clear();
+  ppc::core::Trace::Enable();
+  const int first_tid = span_tid();
+  for (int i = 0; i < 50; i++) {
+    ppc::core::Trace::Clear();
+    EXPECT_EQ(span_tid(), first_tid);
+  }
+  ppc::core::Trace::Disable();
+  ppc::core::Trace::Clear();
+}
+
+TEST(trace_tests, check_task_stages_in_chrome_trace) {
+  // Create data
+  std::vector<int32_t> in(20, 1);
+  std::vector<int32_t> out(1, 0);
+
+  // Create task_data
+  auto task_data = std::make_shared<ppc::core::TaskData>();
+  task_data->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  task_data->inputs_count.emplace_back(in.size());
+  task_data->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  task_data->outputs_count.emplace_back(out.size());
+
+  ppc::core::Trace::Clear();
+  ppc::core::Trace::SetProcessId(3);
+  ppc::core::Trace::Enable();
+
+  // Create Task
+  ppc::test::task::TestTask<int32_t> test_task(task_data);
+  ASSERT_TRUE(test_task.Validation());
+  test_task.PreProcessing();
+  test_task.Run();
+  test_task.PostProcessing();
+  ppc::core::Trace::Disable();
+
+  std::stringstream trace;
+  ppc::core::Trace::WriteChromeTrace(trace);
+  ppc::core::Trace::SetProcessId(0);
+  ppc::core::Trace::Clear();
+
+  const std::string json = trace.str();
+  EXPECT_EQ(json.find("{\"displayTimeUnit\":\"ns\",\"traceEvents\":["), 0U);
+  for (const std::string stage : {"Validation", "PreProcessing", "Run", "PostProcessing"}) {
+    EXPECT_NE(json.find("{\"name\":\"" + stage + "\",\"cat\":\"task\",\"ph\":\"X\""), std::string::npos);
+  }
+  EXPECT_NE(json.find("\"pid\":3"), std::string::npos);
+  EXPECT_EQ(json.substr(json.size() - 4), "\n]}\n");
+}
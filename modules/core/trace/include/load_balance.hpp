@@ -0,0 +1,85 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace ppc::core {
+
+// Work done by every worker of one executed parallel region
+struct RegionStats {
+  const char *name = "";
+  int64_t wall_ns = 0;
+  std::vector<int64_t> busy_ns;
+  std::vector<uint64_t> items;
+
+  // busiest worker relative to the mean one (1 - perfectly balanced)
+  [[nodiscard]] double Imbalance() const;
+  // share of the workers' time inside the region spent without work
+  [[nodiscard]] double IdleFraction() const;
+};
+
+// Wall-time weighted summary over all recorded regions
+struct LoadBalanceSummary {
+  uint64_t regions = 0;
+  double imbalance = 0.0;
+  double worst_imbalance = 0.0;
+  double idle_fraction = 0.0;
+};
+
+// Collector of RegionStats, off by default (a disabled region costs one atomic load)
+class LoadBalance {
+ public:
+  static void Enable();
+  static void Disable();
+  static bool IsEnabled();
+  static void Clear();
+
+  static void Record(RegionStats stats);
+  static std::vector<RegionStats> Regions();
+  static LoadBalanceSummary Summarize();
+};
+
+// RAII accounting of one parallel region inside RunImpl():
+//   ParallelRegion region("rows", num_threads);
+//   ... in worker `id`: WorkerScope scope(region, id, rows_of_this_worker);
+// Workers may enter several scopes; their busy time and items add up.
+class ParallelRegion {
+ public:
+  ParallelRegion(const char *name, int num_workers);
+  ParallelRegion(const ParallelRegion &) = delete;
+  ParallelRegion &operator=(const ParallelRegion &) = delete;
+  ~ParallelRegion();
+
+  [[nodiscard]] bool IsActive() const { return begin_ns_ >= 0; }
+  void AddWork(int worker, int64_t busy_ns, uint64_t items);
+
+ private:
+  // one cache line per worker so that concurrent updates do not contend
+  struct alignas(64) WorkerSlot {
+    std::atomic<int64_t> busy_ns{0};
+    std::atomic<uint64_t> items{0};
+  };
+
+  const char *name_;
+  int64_t begin_ns_ = -1;
+  std::vector<WorkerSlot> workers_;
+};
+
+class WorkerScope {
+ public:
+  WorkerScope(ParallelRegion &region, int worker, uint64_t items = 0);
+  WorkerScope(const WorkerScope &) = delete;
+  WorkerScope &operator=(const WorkerScope &) = delete;
+  ~WorkerScope();
+
+  void AddItems(uint64_t items) { items_ += items; }
+
+ private:
+  ParallelRegion &region_;
+  int worker_;
+  uint64_t items_;
+  int64_t begin_ns_ = -1;
+};
+
+}  // namespace ppc::core
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace ppc::core {
+
+// Timeline recorder for task stages and user-annotated regions.
+// Every thread appends spans into its own buffer without locking; buffers are
+// merged only when the trace is written out, so Write/Clear must be called
+// after all parallel work has finished.
+class Trace {
+ public:
+  // switch recording on/off (off by default, a disabled span costs one atomic load)
+  static void Enable();
+  static void Disable();
+  static bool IsEnabled();
+
+  // drop all recorded spans, keeping already allocated buffers for reuse; the
+  // buffers of exited threads are then handed to new threads
+  static void Clear();
+
+  // process id written to the trace, e.g. MPI rank
+  static void SetProcessId(int pid);
+
+  // number of spans recorded by all threads
+  static size_t EventCount();
+
+  // export recorded spans in Chrome trace event format (chrome://tracing, Perfetto)
+  static void WriteChromeTrace(std::ostream &out);
+  static void WriteChromeTrace(const std::string &path);
+
+  // nanoseconds of the calibrated timer (ppc::util::NowSeconds())
+  static int64_t Now();
+
+  // append a finished span of the calling thread
+  static void Record(const char *name, const char *category, int64_t begin_ns, int64_t end_ns);
+};
+
+// RAII span: records [construction, destruction) of the current thread.
+// `name` and `category` must outlive the trace (string literals are expected).
+class TraceSpan {
+ public:
+  explicit TraceSpan(const char *name, const char *category = "region");
+  TraceSpan(const TraceSpan &) = delete;
+  TraceSpan &operator=(const TraceSpan &) = delete;
+  ~TraceSpan();
+
+ private:
+  const char *name_;
+  const char *category_;
+  int64_t begin_ns_ = -1;
+};
+
+}  // namespace ppc::core
@@ -0,0 +1,132 @@
+#include "core/trace/include/load_balance.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include "core/trace/include/trace.hpp"
+
+namespace {
+
+struct LoadBalanceRegistry {
+  std::mutex mutex;
+  std::vector<ppc::core::RegionStats> regions;
+  std::atomic<bool> enabled{false};
+};
+
+LoadBalanceRegistry &Registry() {
+  static LoadBalanceRegistry registry;
+  return registry;
+}
+
+}  // namespace
+
+double ppc::core::RegionStats::Imbalance() const {
+  if (busy_ns.empty()) {
+    return 1.0;
+  }
+  const double total = std::accumulate(busy_ns.begin(), busy_ns.end(), 0.0);
+  const double mean = total / static_cast<double>(busy_ns.size());
+  return mean > 0.0 ? static_cast<double>(*std::ranges::max_element(busy_ns)) / mean : 1.0;
+}
+
+double ppc::core::RegionStats::IdleFraction() const {
+  const double capacity = static_cast<double>(wall_ns) * static_cast<double>(busy_ns.size());
+  if (capacity <= 0.0) {
+    return 0.0;
+  }
+  const double total = std::accumulate(busy_ns.begin(), busy_ns.end(), 0.0);
+  return std::clamp(1.0 - (total / capacity), 0.0, 1.0);
+}
+
+void ppc::core::LoadBalance::Enable() { Registry().enabled.store(true, std::memory_order_relaxed); }
+
+void ppc::core::LoadBalance::Disable() { Registry().enabled.store(false, std::memory_order_relaxed); }
+
+bool ppc::core::LoadBalance::IsEnabled() { return Registry().enabled.load(std::memory_order_relaxed); }
+
+void ppc::core::LoadBalance::Clear() {
+  auto &registry = Registry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  registry.regions.clear();
+}
+
+void ppc::core::LoadBalance::Record(RegionStats stats) {
+  auto &registry = Registry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  registry.regions.push_back(std::move(stats));
+}
+
+std::vector<ppc::core::RegionStats> ppc::core::LoadBalance::Regions() {
+  auto &registry = Registry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  return registry.regions;
+}
+
+ppc::core::LoadBalanceSummary ppc::core::LoadBalance::Summarize() {
+  LoadBalanceSummary summary;
+  double total_wall = 0.0;
+  double weighted_imbalance = 0.0;
+  double capacity = 0.0;
+  double idle = 0.0;
+  for (const auto &region : Regions()) {
+    const auto wall = static_cast<double>(region.wall_ns);
+    const double region_capacity = wall * static_cast<double>(region.busy_ns.size());
+    summary.regions++;
+    summary.worst_imbalance = std::max(summary.worst_imbalance, region.Imbalance());
+    total_wall += wall;
+    weighted_imbalance += wall * region.Imbalance();
+    capacity += region_capacity;
+    idle += region_capacity * region.IdleFraction();
+  }
+  summary.imbalance = total_wall > 0.0 ? weighted_imbalance / total_wall : 1.0;
+  summary.idle_fraction = capacity > 0.0 ? idle / capacity : 0.0;
+  return summary;
+}
+
+ppc::core::ParallelRegion::ParallelRegion(const char *name, int num_workers) : name_(name) {
+  if (LoadBalance::IsEnabled() && num_workers > 0) {
+    workers_ = std::vector<WorkerSlot>(num_workers);
+    begin_ns_ = Trace::Now();
+  }
+}
+
+ppc::core::ParallelRegion::~ParallelRegion() {
+  if (!IsActive()) {
+    return;
+  }
+  RegionStats stats;
+  stats.name = name_;
+  stats.wall_ns = Trace::Now() - begin_ns_;
+  for (const auto &worker : workers_) {
+    stats.busy_ns.push_back(worker.busy_ns.load(std::memory_order_relaxed));
+    stats.items.push_back(worker.items.load(std::memory_order_relaxed));
+  }
+  LoadBalance::Record(std::move(stats));
+}
+
+void ppc::core::ParallelRegion::AddWork(int worker, int64_t busy_ns, uint64_t items) {
+  if (!IsActive() || worker < 0 || static_cast<size_t>(worker) >= workers_.size()) {
+    return;
+  }
+  workers_[worker].busy_ns.fetch_add(busy_ns, std::memory_order_relaxed);
+  workers_[worker].items.fetch_add(items, std::memory_order_relaxed);
+}
+
+ppc::core::WorkerScope::WorkerScope(ParallelRegion &region, int worker, uint64_t items)
+    : region_(region), worker_(worker), items_(items) {
+  if (region_.IsActive()) {
+    begin_ns_ = Trace::Now();
+  }
+}
+
+ppc::core::WorkerScope::~WorkerScope() {
+  if (begin_ns_ >= 0) {
+    region_.AddWork(worker_, Trace::Now() - begin_ns_, items_);
+  }
+}
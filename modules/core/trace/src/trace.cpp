@@ -0,0 +1,223 @@
+#include "core/trace/include/trace.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "core/util/include/timer.hpp"
+
+namespace {
+
+struct TraceEvent {
+  const char *name;
+  const char *category;
+  int64_t begin_ns;
+  int64_t end_ns;
+};
+
+constexpr size_t kChunkCapacity = 1024;
+
+struct TraceChunk {
+  std::array<TraceEvent, kChunkCapacity> events{};
+  std::atomic<size_t> size{0};
+  std::atomic<TraceChunk *> next{nullptr};
+};
+
+// Single-writer buffer: only the owning thread appends, readers synchronize on `size`
+struct ThreadBuffer {
+  explicit ThreadBuffer(int id) : tid(id) {}
+  ThreadBuffer(const ThreadBuffer &) = delete;
+  ThreadBuffer &operator=(const ThreadBuffer &) = delete;
+  ~ThreadBuffer() {
+    TraceChunk *chunk = head.next.load();
+    while (chunk != nullptr) {
+      TraceChunk *next = chunk->next.load();
+      delete chunk;
+      chunk = next;
+    }
+  }
+
+  void Push(const TraceEvent &event) {
+    TraceChunk *chunk = tail.load(std::memory_order_relaxed);
+    size_t pos = chunk->size.load(std::memory_order_relaxed);
+    if (pos == kChunkCapacity) {
+      TraceChunk *next = chunk->next.load(std::memory_order_relaxed);
+      if (next == nullptr) {
+        next = new TraceChunk();
+        chunk->next.store(next, std::memory_order_release);
+      }
+      chunk = next;
+      tail.store(chunk, std::memory_order_relaxed);
+      pos = chunk->size.load(std::memory_order_relaxed);
+    }
+    chunk->events[pos] = event;
+    chunk->size.store(pos + 1, std::memory_order_release);
+  }
+
+  [[nodiscard]] bool Empty() const { return head.size.load(std::memory_order_acquire) == 0; }
+
+  int tid;
+  TraceChunk head;
+  std::atomic<TraceChunk *> tail{&head};
+  // false once the owning thread exited, guarded by the registry mutex
+  bool owned = true;
+};
+
+struct TraceRegistry {
+  std::mutex mutex;
+  std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+  std::atomic<bool> enabled{false};
+  std::atomic<int> pid{0};
+};
+
+TraceRegistry &Registry() {
+  static TraceRegistry registry;
+  return registry;
+}
+
+// Gives the buffer up when its thread exits; the spans stay until they are cleared
+struct BufferLease {
+  BufferLease() = default;
+  BufferLease(const BufferLease &) = delete;
+  BufferLease &operator=(const BufferLease &) = delete;
+  ~BufferLease() {
+    if (buffer != nullptr) {
+      auto &registry = Registry();
+      std::lock_guard<std::mutex> lock(registry.mutex);
+      buffer->owned = false;
+    }
+  }
+
+  ThreadBuffer *buffer = nullptr;
+};
+
+ThreadBuffer &LocalBuffer() {
+  thread_local BufferLease lease;
+  if (lease.buffer == nullptr) {
+    auto &registry = Registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    // a buffer of an exited thread is reused once its spans are cleared, so
+    // short-lived threads do not grow the registry
+    for (auto &buffer : registry.buffers) {
+      if (!buffer->owned && buffer->Empty()) {
+        lease.buffer = buffer.get();
+        break;
+      }
+    }
+    if (lease.buffer == nullptr) {
+      registry.buffers.emplace_back(std::make_unique<ThreadBuffer>(static_cast<int>(registry.buffers.size())));
+      lease.buffer = registry.buffers.back().get();
+    }
+    lease.buffer->owned = true;
+  }
+  return *lease.buffer;
+}
+
+void WriteJsonString(std::ostream &out, const char *str) {
+  out << '"';
+  for (const char *c = str; *c != '\0'; c++) {
+    if (*c == '"' || *c == '\\') {
+      out << '\\' << *c;
+    } else if (static_cast<unsigned char>(*c) < 0x20) {
+      out << ' ';
+    } else {
+      out << *c;
+    }
+  }
+  out << '"';
+}
+
+}  // namespace
+
+void ppc::core::Trace::Enable() { Registry().enabled.store(true, std::memory_order_relaxed); }
+
+void ppc::core::Trace::Disable() { Registry().enabled.store(false, std::memory_order_relaxed); }
+
+bool ppc::core::Trace::IsEnabled() { return Registry().enabled.load(std::memory_order_relaxed); }
+
+void ppc::core::Trace::Clear() {
+  auto &registry = Registry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  for (auto &buffer : registry.buffers) {
+    for (TraceChunk *chunk = &buffer->head; chunk != nullptr; chunk = chunk->next.load(std::memory_order_acquire)) {
+      chunk->size.store(0, std::memory_order_relaxed);
+    }
+    buffer->tail.store(&buffer->head, std::memory_order_relaxed);
+  }
+}
+
+void ppc::core::Trace::SetProcessId(int pid) { Registry().pid.store(pid, std::memory_order_relaxed); }
+
+size_t ppc::core::Trace::EventCount() {
+  auto &registry = Registry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  size_t count = 0;
+  for (const auto &buffer : registry.buffers) {
+    for (TraceChunk *chunk = &buffer->head; chunk != nullptr; chunk = chunk->next.load(std::memory_order_acquire)) {
+      count += chunk->size.load(std::memory_order_acquire);
+    }
+  }
+  return count;
+}
+
+void ppc::core::Trace::WriteChromeTrace(std::ostream &out) {
+  auto &registry = Registry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  const int pid = registry.pid.load(std::memory_order_relaxed);
+
+  out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+  bool first = true;
+  out << std::fixed << std::setprecision(3);
+  for (const auto &buffer : registry.buffers) {
+    for (TraceChunk *chunk = &buffer->head; chunk != nullptr; chunk = chunk->next.load(std::memory_order_acquire)) {
+      const size_t size = chunk->size.load(std::memory_order_acquire);
+      for (size_t i = 0; i < size; i++) {
+        const auto &event = chunk->events[i];
+        out << (first ? "\n" : ",\n") << "{\"name\":";
+        WriteJsonString(out, event.name);
+        out << ",\"cat\":";
+        WriteJsonString(out, event.category);
+        out << ",\"ph\":\"X\",\"ts\":" << static_cast<double>(event.begin_ns) * 1e-3
+            << ",\"dur\":" << static_cast<double>(event.end_ns - event.begin_ns) * 1e-3 << ",\"pid\":" << pid
+            << ",\"tid\":" << buffer->tid << "}";
+        first = false;
+      }
+    }
+  }
+  out << "\n]}\n";
+}
+
+void ppc::core::Trace::WriteChromeTrace(const std::string &path) {
+  std::ofstream file(path);
+  if (!file.is_open()) {
+    throw std::runtime_error("Can't open trace file: " + path);
+  }
+  WriteChromeTrace(file);
+}
+
+int64_t ppc::core::Trace::Now() { return static_cast<int64_t>(ppc::util::NowSeconds() * 1e9); }
+
+void ppc::core::Trace::Record(const char *name, const char *category, int64_t begin_ns, int64_t end_ns) {
+  LocalBuffer().Push(TraceEvent{.name = name, .category = category, .begin_ns = begin_ns, .end_ns = end_ns});
+}
+
+ppc::core::TraceSpan::TraceSpan(const char *name, const char *category) : name_(name), category_(category) {
+  if (Trace::IsEnabled()) {
+    begin_ns_ = Trace::Now();
+  }
+}
+
+ppc::core::TraceSpan::~TraceSpan() {
+  if (begin_ns_ >= 0) {
+    Trace::Record(name_, category_, begin_ns_, Trace::Now());
+  }
+}
@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/util/include/affinity.hpp"
+#include "core/util/include/thread_pool.hpp"
+
+namespace {
+
+// two packages of two cores with two SMT siblings each, numbered the way
+// Linux usually does: siblings are `cores` apart
+std::vector<ppc::util::CpuLocation> TwoSocketTopology() {
+  std::vector<ppc::util::CpuLocation> cpus;
+  for (int cpu = 0; cpu < 8; cpu++) {
+    const int core = cpu % 4;
+    cpus.push_back({cpu, core / 2, core % 2});
+  }
+  return cpus;
+}
+
+}  // namespace
+
+TEST(affinity_tests, check_parse) {
+  EXPECT_EQ(ppc::util::AffinityPolicy::Parse("none").kind, ppc::util::AffinityKind::kNone);
+  EXPECT_EQ(ppc::util::AffinityPolicy::Parse("compact").kind, ppc::util::AffinityKind::kCompact);
+  EXPECT_EQ(ppc::util::AffinityPolicy::Parse("scatter").kind, ppc::util::AffinityKind::kScatter);
+
+  const auto policy = ppc::util::AffinityPolicy::Parse("3,0,5-7");
+  EXPECT_EQ(policy.kind, ppc::util::AffinityKind::kExplicit);
+  EXPECT_EQ(policy.cpus, (std::vector<int>{3, 0, 5, 6, 7}));
+  EXPECT_EQ(policy.Name(), "explicit");
+}
+
+TEST(affinity_tests, check_parse_rejects_malformed) {
+  for (const std::string text : {"", "close", "1,,2", "4-2", "-1", "1-"}) {
+    EXPECT_THROW(ppc::util::AffinityPolicy::Parse(text), std::invalid_argument) << text;
+  }
+}
+
+TEST(affinity_tests, check_compact_fills_cores_then_packages) {
+  const auto placement =
+      ppc::util::PlanPlacement(ppc::util::AffinityPolicy::Parse("compact"), 8, TwoSocketTopology());
+
+  EXPECT_EQ(placement, (std::vector<int>{0, 4, 1, 5, 2, 6, 3, 7}));
+}
+
+TEST(affinity_tests, check_scatter_spreads_over_packages_then_cores) {
+  const auto placement =
+      ppc::util::PlanPlacement(ppc::util::AffinityPolicy::Parse("scatter"), 8, TwoSocketTopology());
+
+  EXPECT_EQ(placement, (std::vector<int>{0, 2, 1, 3, 4, 6, 5, 7}));
+}
+
+TEST(affinity_tests, check_threads_wrap_around) {
+  const auto placement = ppc::util::PlanPlacement(ppc::util::AffinityPolicy::Parse("2,5"), 5, TwoSocketTopology());
+
+  EXPECT_EQ(placement, (std::vector<int>{2, 5, 2, 5, 2}));
+  EXPECT_TRUE(ppc::util::PlanPlacement(ppc::util::AffinityPolicy{}, 4, TwoSocketTopology()).empty());
+}
+
+TEST(affinity_tests, check_topology_lists_allowed_cpus) {
+  const auto cpus = ppc::util::GetCpuTopology();
+
+  ASSERT_FALSE(cpus.empty());
+  for (size_t i = 1; i < cpus.size(); i++) {
+    EXPECT_LT(cpus[i - 1].cpu, cpus[i].cpu);
+  }
+}
+
+TEST(affinity_tests, check_pool_records_placement) {
+  const int cpu = ppc::util::GetCpuTopology().front().cpu;
+  ppc::util::ThreadPool pool(2);
+  // the caller gets pinned too: use a thread of its own
+  std::thread([&] { pool.SetAffinity(ppc::util::AffinityPolicy::Parse(std::to_string(cpu))); }).join();
+
+#ifdef __linux__
+  const std::string expected = "stl:explicit[" + std::to_string(cpu) + "," + std::to_string(cpu) + "]";
+  EXPECT_NE(ppc::util::PlacementSummary().find(expected), std::string::npos) << ppc::util::PlacementSummary();
+#endif
+}
+
+TEST(affinity_tests, check_partition_cpus_gives_disjoint_shares) {
+  const auto cpus = TwoSocketTopology();
+
+  EXPECT_EQ(ppc::util::PartitionCpus(cpus, 0, 2), (std::vector<int>{0, 4, 1, 5}));
+  EXPECT_EQ(ppc::util::PartitionCpus(cpus, 1, 2), (std::vector<int>{2, 6, 3, 7}));
+  // 8 CPUs for 3 processes: 3 + 3 + 2
+  EXPECT_EQ(ppc::util::PartitionCpus(cpus, 0, 3), (std::vector<int>{0, 4, 1}));
+  EXPECT_EQ(ppc::util::PartitionCpus(cpus, 1, 3), (std::vector<int>{5, 2, 6}));
+  EXPECT_EQ(ppc::util::PartitionCpus(cpus, 2, 3), (std::vector<int>{3, 7}));
+}
+
+TEST(affinity_tests, check_partition_cpus_with_more_processes_than_cpus) {
+  const auto cpus = TwoSocketTopology();
+
+  EXPECT_EQ(ppc::util::PartitionCpus(cpus, 9, 10), (std::vector<int>{4}));
+  EXPECT_THROW(ppc::util::PartitionCpus(cpus, 2, 2), std::invalid_argument);
+}
@@ -0,0 +1,40 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <stdexcept>
+
+#include "core/util/include/cpu_dispatch.hpp"
+
+namespace {
+
+int Scalar() { return 0; }
+int Avx2() { return 2; }
+
+}  // namespace
+
+TEST(cpu_dispatch_tests, check_isa_names_round_trip) {
+  for (auto level : {ppc::util::IsaLevel::kScalar, ppc::util::IsaLevel::kSse42, ppc::util::IsaLevel::kAvx2,
+                     ppc::util::IsaLevel::kAvx512}) {
+    EXPECT_EQ(ppc::util::ParseIsaLevel(ppc::util::IsaName(level)), level);
+  }
+  EXPECT_THROW(ppc::util::ParseIsaLevel("avx"), std::invalid_argument);
+}
+
+TEST(cpu_dispatch_tests, check_level_is_capped_by_the_cpu) {
+  const auto detected = ppc::util::DetectIsaLevel();
+  const auto saved = ppc::util::SetIsaLevel(ppc::util::IsaLevel::kAvx512);
+  EXPECT_EQ(ppc::util::GetIsaLevel(), detected);
+
+  ppc::util::SetIsaLevel(ppc::util::IsaLevel::kScalar);
+  EXPECT_EQ(ppc::util::GetIsaLevel(), ppc::util::IsaLevel::kScalar);
+  ppc::util::SetIsaLevel(saved);
+}
+
+TEST(cpu_dispatch_tests, check_table_falls_back_to_lower_variants) {
+  const ppc::util::DispatchTable<int()> table(std::array<int (*)(), ppc::util::kIsaLevels>{Scalar, nullptr, Avx2, nullptr});
+
+  EXPECT_EQ(table.Select(ppc::util::IsaLevel::kScalar)(), 0);
+  EXPECT_EQ(table.Select(ppc::util::IsaLevel::kSse42)(), 0);
+  EXPECT_EQ(table.Select(ppc::util::IsaLevel::kAvx2)(), 2);
+  EXPECT_EQ(table.Select(ppc::util::IsaLevel::kAvx512)(), 2);
+}
@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "core/util/include/deterministic_reduce.hpp"
+#include "core/util/include/parallel.hpp"
+
+namespace {
+
+std::vector<float> IllConditioned(size_t n) {
+  std::vector<float> values(n);
+  for (size_t i = 0; i < n; i++) {
+    values[i] = (i % 7 == 0) ? 3.0e6F : 0.01F * static_cast<float>(i % 13);
+  }
+  return values;
+}
+
+}  // namespace
+
+TEST(deterministic_reduce_tests, check_same_bits_for_every_backend) {
+  const auto values = IllConditioned(300001);
+  const float expected = ppc::util::DeterministicSum<ppc::util::policy::Seq>(values);
+
+  EXPECT_EQ(ppc::util::DeterministicSum<ppc::util::policy::StdThread>(values), expected);
+#ifdef _OPENMP
+  const int save_threads = omp_get_max_threads();
+  for (int threads : {1, 2, 3, 4}) {
+    omp_set_num_threads(threads);
+    EXPECT_EQ(ppc::util::DeterministicSum<ppc::util::policy::OpenMP>(values), expected) << threads << " threads";
+  }
+  omp_set_num_threads(save_threads);
+#else
+  EXPECT_EQ(ppc::util::DeterministicSum<ppc::util::policy::OpenMP>(values), expected);
+#endif
+}
+
+TEST(deterministic_reduce_tests, check_block_edges) {
+  std::vector<int64_t> values(10000);
+  for (size_t i = 0; i < values.size(); i++) {
+    values[i] = static_cast<int64_t>(i);
+  }
+  for (size_t block : {size_t{1}, size_t{3}, size_t{4096}, size_t{20000}}) {
+    EXPECT_EQ(ppc::util::DeterministicSum<ppc::util::policy::StdThread>(values, block), 49995000) << block;
+  }
+  EXPECT_EQ(ppc::util::DeterministicSum<ppc::util::policy::Seq>(std::vector<double>{}), 0.0);
+}
+
+TEST(deterministic_reduce_tests, check_custom_combine) {
+  const std::vector<double> values = {3.5, -1.0, 8.25, 2.0, 8.0};
+  auto max = [](double a, double b) { return std::max(a, b); };
+  const double result = ppc::util::DeterministicReduce<ppc::util::policy::StdThread>(
+      values.size(), -1.0e300, [&](size_t i) { return values[i]; }, max, 2);
+  EXPECT_EQ(result, 8.25);
+}
+
+TEST(deterministic_reduce_tests, check_tree_is_more_accurate_than_loop) {
+  std::vector<float> values(1 << 20, 0.1F);
+  float naive = 0.0F;
+  for (float value : values) {
+    naive += value;
+  }
+  const double exact = 0.1F * static_cast<double>(values.size());
+  const float tree = ppc::util::DeterministicSum<ppc::util::policy::Seq>(values);
+  EXPECT_LT(std::abs(tree - exact), std::abs(naive - exact));
+}
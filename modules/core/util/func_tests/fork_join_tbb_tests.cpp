@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "core/util/include/fork_join.hpp"
+#include "core/util/include/fork_join_tbb.hpp"
+#include "core/util/include/parallel.hpp"
+#include "oneapi/tbb/task_arena.h"
+
+// The TBB backend of fork_join.hpp, built only with USE_TBB
+namespace {
+
+using Policy = ppc::util::policy::TBB;
+
+void MergeSort(std::vector<int> &values, std::vector<int> &buffer, size_t first, size_t last) {
+  if (last - first < 2) {
+    return;
+  }
+  const size_t middle = first + ((last - first) / 2);
+  ppc::util::ForkJoin<Policy>(
+      last - first, 256, [&] { MergeSort(values, buffer, first, middle); },
+      [&] { MergeSort(values, buffer, middle, last); });
+  std::merge(values.begin() + first, values.begin() + middle, values.begin() + middle, values.begin() + last,
+             buffer.begin() + first);
+  std::copy(buffer.begin() + first, buffer.begin() + last, values.begin() + first);
+}
+
+int64_t CountLeaves(int depth) {
+  if (depth == 0) {
+    return 1;
+  }
+  int64_t left = 0;
+  ppc::util::TaskGroup<Policy> group;
+  group.Spawn([&] { left = CountLeaves(depth - 1); });
+  const int64_t right = CountLeaves(depth - 1);
+  group.Sync();
+  return left + right;
+}
+
+}  // namespace
+
+TEST(fork_join_tbb_tests, check_merge_sort) {
+  std::vector<int> values(20000);
+  for (size_t i = 0; i < values.size(); i++) {
+    values[i] = static_cast<int>((i * 7919) % 10007);
+  }
+  std::vector<int> expected = values;
+  std::ranges::sort(expected);
+
+  std::vector<int> buffer(values.size());
+  oneapi::tbb::task_arena arena(4);
+  arena.execute([&] { ppc::util::ForkJoinRoot<Policy>([&] { MergeSort(values, buffer, 0, values.size()); }); });
+  EXPECT_EQ(values, expected);
+}
+
+TEST(fork_join_tbb_tests, check_deep_recursion_without_cutoff) {
+  int64_t leaves = 0;
+  oneapi::tbb::task_arena arena(4);
+  arena.execute([&] { leaves = CountLeaves(12); });
+  EXPECT_EQ(leaves, 4096);
+}
+
+TEST(fork_join_tbb_tests, check_child_exception_is_rethrown) {
+  ppc::util::TaskGroup<Policy> group;
+  group.Spawn([] { throw std::runtime_error("child failed"); });
+  group.Spawn([] {});
+  EXPECT_THROW(group.Sync(), std::runtime_error);
+  EXPECT_NO_THROW(group.Sync());
+}
@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "core/util/include/fork_join.hpp"
+#include "core/util/include/parallel.hpp"
+#include "core/util/include/thread_pool.hpp"
+
+namespace {
+
+template <typename Policy>
+void MergeSort(std::vector<int> &values, std::vector<int> &buffer, size_t first, size_t last) {
+  if (last - first < 2) {
+    return;
+  }
+  const size_t middle = first + ((last - first) / 2);
+  ppc::util::ForkJoin<Policy>(
+      last - first, 256, [&] { MergeSort<Policy>(values, buffer, first, middle); },
+      [&] { MergeSort<Policy>(values, buffer, middle, last); });
+  std::merge(values.begin() + first, values.begin() + middle, values.begin() + middle, values.begin() + last,
+             buffer.begin() + first);
+  std::copy(buffer.begin() + first, buffer.begin() + last, values.begin() + first);
+}
+
+template <typename Policy>
+void CheckMergeSort() {
+  std::vector<int> values(20000);
+  for (size_t i = 0; i < values.size(); i++) {
+    values[i] = static_cast<int>((i * 7919) % 10007);
+  }
+  std::vector<int> expected = values;
+  std::ranges::sort(expected);
+
+  std::vector<int> buffer(values.size());
+  ppc::util::ForkJoinRoot<Policy>([&] { MergeSort<Policy>(values, buffer, 0, values.size()); });
+  EXPECT_EQ(values, expected);
+}
+
+template <typename Policy>
+int64_t CountLeaves(int depth) {
+  if (depth == 0) {
+    return 1;
+  }
+  int64_t left = 0;
+  ppc::util::TaskGroup<Policy> group;
+  group.Spawn([&] { left = CountLeaves<Policy>(depth - 1); });
+  const int64_t right = CountLeaves<Policy>(depth - 1);
+  group.Sync();
+  return left + right;
+}
+
+}  // namespace
+
+TEST(fork_join_tests, check_merge_sort_seq) { CheckMergeSort<ppc::util::policy::Seq>(); }
+
+TEST(fork_join_tests, check_merge_sort_openmp) { CheckMergeSort<ppc::util::policy::OpenMP>(); }
+
+TEST(fork_join_tests, check_merge_sort_std_thread) { CheckMergeSort<ppc::util::policy::StdThread>(); }
+
+TEST(fork_join_tests, check_deep_recursion_without_cutoff) {
+  int64_t omp_leaves = 0;
+  ppc::util::ForkJoinRoot<ppc::util::policy::OpenMP>(
+      [&] { omp_leaves = CountLeaves<ppc::util::policy::OpenMP>(12); });
+  EXPECT_EQ(omp_leaves, 4096);
+  EXPECT_EQ(CountLeaves<ppc::util::policy::StdThread>(12), 4096);
+}
+
+TEST(fork_join_tests, check_cutoff_runs_inline) {
+  std::atomic<int> calls = 0;
+  const auto caller = std::this_thread::get_id();
+  auto count = [&] {
+    EXPECT_EQ(std::this_thread::get_id(), caller);
+    calls++;
+  };
+  ppc::util::ForkJoin<ppc::util::policy::StdThread>(10, 100, count, count);
+  EXPECT_EQ(calls.load(), 2);
+}
+
+TEST(fork_join_tests, check_child_exception_is_rethrown) {
+  ppc::util::ThreadPool pool(2);
+  ppc::util::TaskGroup<ppc::util::policy::StdThread> group(pool);
+  group.Spawn([] { throw std::runtime_error("child failed"); });
+  group.Spawn([] {});
+  EXPECT_THROW(group.Sync(), std::runtime_error);
+  EXPECT_NO_THROW(group.Sync());
+}
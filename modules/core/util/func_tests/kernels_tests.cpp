@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "core/util/include/cpu_dispatch.hpp"
+#include "core/util/include/kernels.hpp"
+
+namespace {
+
+std::vector<float> IllConditioned(size_t n) {
+  std::vector<float> values(n);
+  for (size_t i = 0; i < n; i++) {
+    values[i] = (i % 7 == 0) ? 3.0e6F : 0.01F * static_cast<float>(i % 13);
+  }
+  return values;
+}
+
+// every level the CPU supports, from scalar up
+std::vector<ppc::util::IsaLevel> SupportedLevels() {
+  std::vector<ppc::util::IsaLevel> levels;
+  for (size_t level = 0; level <= static_cast<size_t>(ppc::util::DetectIsaLevel()); level++) {
+    levels.push_back(static_cast<ppc::util::IsaLevel>(level));
+  }
+  return levels;
+}
+
+}  // namespace
+
+TEST(kernels_tests, check_sum_uses_fixed_lanes) {
+  const auto values = IllConditioned(1000);
+  std::vector<float> lanes(ppc::util::kKernelLanes, 0.0F);
+  for (size_t i = 0; i < values.size(); i++) {
+    lanes[i % lanes.size()] += values[i];
+  }
+  for (size_t width = lanes.size() / 2; width > 0; width /= 2) {
+    for (size_t lane = 0; lane < width; lane++) {
+      lanes[lane] += lanes[lane + width];
+    }
+  }
+
+  EXPECT_EQ(ppc::util::SumBlock(values.data(), values.size()), lanes[0]);
+}
+
+TEST(kernels_tests, check_same_bits_for_every_isa_level) {
+  const auto x = IllConditioned(4099);
+  const auto y = IllConditioned(4100);
+  const std::vector<double> xd(x.begin(), x.end());
+  const auto saved = ppc::util::GetIsaLevel();
+
+  ppc::util::SetIsaLevel(ppc::util::IsaLevel::kScalar);
+  const float sum = ppc::util::SumBlock(x.data(), x.size());
+  const double sum_double = ppc::util::SumBlock(xd.data(), xd.size());
+  const double dot = ppc::util::DotBlock(x.data(), y.data() + 1, x.size());
+  const double dot_double = ppc::util::DotBlock(xd.data(), xd.data(), xd.size());
+  for (auto level : SupportedLevels()) {
+    ppc::util::SetIsaLevel(level);
+    EXPECT_EQ(ppc::util::SumBlock(x.data(), x.size()), sum) << ppc::util::IsaName(level);
+    EXPECT_EQ(ppc::util::SumBlock(xd.data(), xd.size()), sum_double) << ppc::util::IsaName(level);
+    EXPECT_EQ(ppc::util::DotBlock(x.data(), y.data() + 1, x.size()), dot) << ppc::util::IsaName(level);
+    EXPECT_EQ(ppc::util::DotBlock(xd.data(), xd.data(), xd.size()), dot_double) << ppc::util::IsaName(level);
+  }
+  ppc::util::SetIsaLevel(saved);
+}
+
+TEST(kernels_tests, check_gemm_rows_for_every_isa_level) {
+  const size_t n = 37;
+  std::vector<int> a(n * n);
+  std::vector<double> ad(n * n);
+  for (size_t i = 0; i < a.size(); i++) {
+    a[i] = static_cast<int>(i % 11) - 5;
+    ad[i] = 0.5 * a[i];
+  }
+  std::vector<int> expected(n * n, 0);
+  for (size_t i = 0; i < n; i++) {
+    for (size_t j = 0; j < n; j++) {
+      for (size_t k = 0; k < n; k++) {
+        expected[(i * n) + j] += a[(i * n) + k] * a[(k * n) + j];
+      }
+    }
+  }
+
+  const auto saved = ppc::util::GetIsaLevel();
+  for (auto level : SupportedLevels()) {
+    ppc::util::SetIsaLevel(level);
+    std::vector<int> c(n * n, -1);
+    ppc::util::GemmRows(a.data(), a.data(), c.data(), n, 0, 20);
+    ppc::util::GemmRows(a.data(), a.data(), c.data(), n, 20, n);
+    EXPECT_EQ(c, expected) << ppc::util::IsaName(level);
+
+    std::vector<double> cd(n * n);
+    ppc::util::GemmRows(ad.data(), ad.data(), cd.data(), n, 0, n);
+    for (size_t i = 0; i < cd.size(); i++) {
+      ASSERT_EQ(cd[i], 0.25 * expected[i]) << ppc::util::IsaName(level);
+    }
+  }
+  ppc::util::SetIsaLevel(saved);
+}
+
+TEST(kernels_tests, check_fma_peak_for_every_isa_level) {
+  const auto saved = ppc::util::GetIsaLevel();
+  for (auto level : SupportedLevels()) {
+    ppc::util::SetIsaLevel(level);
+    double sink = 0.0;
+    // two operations per lane and round
+    const double flops = ppc::util::FmaPeak(1000, sink);
+    EXPECT_GT(flops, 0.0) << ppc::util::IsaName(level);
+    EXPECT_EQ(static_cast<int64_t>(flops) % 2000, 0) << ppc::util::IsaName(level);
+    EXPECT_GT(sink, 0.0) << ppc::util::IsaName(level);
+  }
+  ppc::util::SetIsaLevel(saved);
+}
@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <vector>
+
+#include "core/util/include/parallel.hpp"
+#include "core/util/include/parallel_tbb.hpp"
+#include "oneapi/tbb/task_arena.h"
+
+// The TBB backend of parallel.hpp, built only with USE_TBB
+namespace {
+
+using Policy = ppc::util::policy::TBB;
+
+std::vector<int64_t> Squares(size_t n, size_t grain) {
+  std::vector<int64_t> out(n, -1);
+  ppc::util::ParallelFor<Policy>(size_t{0}, n, [&](size_t i) { out[i] = static_cast<int64_t>(i * i); }, grain);
+  return out;
+}
+
+int64_t SumOfSquares(int begin, int end, size_t grain) {
+  return ppc::util::ParallelReduce<Policy>(
+      begin, end, int64_t{0}, [](int i) { return static_cast<int64_t>(i) * i; }, std::plus<>(), grain);
+}
+
+}  // namespace
+
+TEST(parallel_tbb_tests, check_tbb) {
+  std::vector<int64_t> expected(1000);
+  for (size_t i = 0; i < expected.size(); i++) {
+    expected[i] = static_cast<int64_t>(i * i);
+  }
+  const int64_t expected_sum = std::accumulate(expected.begin() + 10, expected.end(), int64_t{0});
+
+  for (size_t grain : {size_t{0}, size_t{1}, size_t{64}, size_t{5000}}) {
+    EXPECT_EQ(Squares(expected.size(), grain), expected) << "grain " << grain;
+    EXPECT_EQ(SumOfSquares(10, 1000, grain), expected_sum) << "grain " << grain;
+  }
+  EXPECT_EQ(SumOfSquares(5, 5, 0), 0);
+  EXPECT_GE(ppc::util::NumWorkers<Policy>(), 1);
+}
+
+TEST(parallel_tbb_tests, check_worker_index_in_range) {
+  oneapi::tbb::task_arena arena(4);
+  arena.execute([] {
+    EXPECT_EQ(ppc::util::NumWorkers<Policy>(), 4);
+    std::vector<int> indices(256, -1);
+    auto record = [&](size_t i) { indices[i] = ppc::util::WorkerIndex<Policy>(); };
+    ppc::util::ParallelFor<Policy>(size_t{0}, indices.size(), record, 1);
+    for (int index : indices) {
+      EXPECT_GE(index, 0);
+      EXPECT_LT(index, 4);
+    }
+  });
+}
@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <vector>
+
+#include "core/util/include/parallel.hpp"
+
+namespace {
+
+// the same kernel body for every backend
+template <typename Policy>
+std::vector<int64_t> Squares(size_t n, size_t grain) {
+  std::vector<int64_t> out(n, -1);
+  ppc::util::ParallelFor<Policy>(size_t{0}, n, [&](size_t i) { out[i] = static_cast<int64_t>(i * i); }, grain);
+  return out;
+}
+
+template <typename Policy>
+int64_t SumOfSquares(int begin, int end, size_t grain) {
+  return ppc::util::ParallelReduce<Policy>(
+      begin, end, int64_t{0}, [](int i) { return static_cast<int64_t>(i) * i; }, std::plus<>(), grain);
+}
+
+template <typename Policy>
+void CheckBackend() {
+  std::vector<int64_t> expected(1000);
+  for (size_t i = 0; i < expected.size(); i++) {
+    expected[i] = static_cast<int64_t>(i * i);
+  }
+  const int64_t expected_sum = std::accumulate(expected.begin() + 10, expected.end(), int64_t{0});
+
+  for (size_t grain : {size_t{0}, size_t{1}, size_t{64}, size_t{5000}}) {
+    EXPECT_EQ(Squares<Policy>(expected.size(), grain), expected) << "grain " << grain;
+    EXPECT_EQ(SumOfSquares<Policy>(10, 1000, grain), expected_sum) << "grain " << grain;
+  }
+  EXPECT_EQ(SumOfSquares<Policy>(5, 5, 0), 0);
+  EXPECT_GE(ppc::util::NumWorkers<Policy>(), 1);
+}
+
+}  // namespace
+
+TEST(parallel_tests, check_seq) { CheckBackend<ppc::util::policy::Seq>(); }
+
+TEST(parallel_tests, check_openmp) { CheckBackend<ppc::util::policy::OpenMP>(); }
+
+TEST(parallel_tests, check_std_thread) { CheckBackend<ppc::util::policy::StdThread>(); }
+
+TEST(parallel_tests, check_worker_index_in_range) {
+  using Policy = ppc::util::policy::StdThread;
+  std::vector<int> indices(256, -1);
+  auto record = [&](size_t i) { indices[i] = ppc::util::WorkerIndex<Policy>(); };
+  ppc::util::ParallelFor<Policy>(size_t{0}, indices.size(), record, 1);
+  for (int index : indices) {
+    EXPECT_GE(index, 0);
+    EXPECT_LT(index, ppc::util::NumWorkers<Policy>());
+  }
+}
@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+#include "core/util/include/parallel.hpp"
+#include "core/util/include/random.hpp"
+
+// known-answer vectors of the Random123 reference implementation
+TEST(random_tests, check_philox_known_answers) {
+  EXPECT_EQ(ppc::util::Philox4x32({0, 0, 0, 0}, {0, 0}),
+            (ppc::util::PhiloxBlock{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}));
+  EXPECT_EQ(ppc::util::Philox4x32({0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}, {0xffffffff, 0xffffffff}),
+            (ppc::util::PhiloxBlock{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}));
+  EXPECT_EQ(ppc::util::Philox4x32({0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}, {0xa4093822, 0x299f31d0}),
+            (ppc::util::PhiloxBlock{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}));
+}
+
+TEST(random_tests, check_streams_and_seeds_differ) {
+  const ppc::util::CounterRng rng(7);
+  EXPECT_NE(rng.Block(0), ppc::util::CounterRng(8).Block(0));
+  EXPECT_NE(rng.Block(0), ppc::util::CounterRng(7, 1).Block(0));
+  EXPECT_EQ(rng.Word(5), rng.Block(1)[1]);
+  EXPECT_EQ(rng.Bits64(3), (uint64_t{rng.Block(1)[3]} << 32) | rng.Block(1)[2]);
+}
+
+TEST(random_tests, check_same_bits_for_every_policy) {
+  constexpr size_t kCount = 100003;
+  const auto seq = ppc::util::RandomVector<ppc::util::policy::Seq>(kCount, -1.0F, 1.0F, 42);
+  EXPECT_EQ(seq, (ppc::util::RandomVector<ppc::util::policy::OpenMP>(kCount, -1.0F, 1.0F, 42)));
+  EXPECT_EQ(seq, (ppc::util::RandomVector<ppc::util::policy::StdThread>(kCount, -1.0F, 1.0F, 42)));
+
+  const auto image = ppc::util::RandomBinaryImage<ppc::util::policy::Seq>(333, 301, 0.3, 5);
+  EXPECT_EQ(image, ppc::util::RandomBinaryImage<ppc::util::policy::StdThread>(333, 301, 0.3, 5));
+}
+
+TEST(random_tests, check_values_do_not_depend_on_size) {
+  const auto small = ppc::util::RandomVector<ppc::util::policy::Seq>(size_t{37}, int64_t{-5}, int64_t{5}, 3);
+  const auto large = ppc::util::RandomVector<ppc::util::policy::Seq>(size_t{10000}, int64_t{-5}, int64_t{5}, 3);
+  EXPECT_TRUE(std::equal(small.begin(), small.end(), large.begin()));
+}
+
+TEST(random_tests, check_integer_ranges) {
+  const auto dice = ppc::util::RandomVector<ppc::util::policy::Seq>(size_t{6000}, 1, 6, 11);
+  EXPECT_EQ(*std::min_element(dice.begin(), dice.end()), 1);
+  EXPECT_EQ(*std::max_element(dice.begin(), dice.end()), 6);
+
+  const auto bytes = ppc::util::RandomVector<ppc::util::policy::Seq>(size_t{6000}, int8_t{-128}, int8_t{127}, 11);
+  EXPECT_EQ(*std::min_element(bytes.begin(), bytes.end()), -128);
+  EXPECT_EQ(*std::max_element(bytes.begin(), bytes.end()), 127);
+
+  // the full range takes the bits as they are
+  const auto full = ppc::util::RandomVector<ppc::util::policy::Seq>(size_t{1000}, std::numeric_limits<int64_t>::min(),
+                                                                     std::numeric_limits<int64_t>::max(), 11);
+  EXPECT_LT(*std::min_element(full.begin(), full.end()), 0);
+  EXPECT_GT(*std::max_element(full.begin(), full.end()), 0);
+}
+
+TEST(random_tests, check_floating_point_range) {
+  const auto values = ppc::util::RandomVector<ppc::util::policy::Seq>(size_t{10000}, 2.0, 3.0, 1);
+  EXPECT_GE(*std::min_element(values.begin(), values.end()), 2.0);
+  EXPECT_LT(*std::max_element(values.begin(), values.end()), 3.0);
+  const double mean = std::accumulate(values.begin(), values.end(), 0.0) / static_cast<double>(values.size());
+  EXPECT_NEAR(mean, 2.5, 0.02);
+}
+
+TEST(random_tests, check_binary_image_density) {
+  constexpr size_t kWidth = 512;
+  constexpr size_t kHeight = 256;
+  const auto image = ppc::util::RandomBinaryImage<ppc::util::policy::Seq>(kWidth, kHeight, 0.25, 9);
+  ASSERT_EQ(image.size(), kWidth * kHeight);
+  const auto set = static_cast<double>(std::count(image.begin(), image.end(), 1));
+  EXPECT_NEAR(set / static_cast<double>(image.size()), 0.25, 0.01);
+  EXPECT_EQ(std::count(image.begin(), image.end(), 0) + std::count(image.begin(), image.end(), 1),
+            static_cast<std::ptrdiff_t>(image.size()));
+
+  const auto empty = ppc::util::RandomBinaryImage<ppc::util::policy::Seq>(kWidth, kHeight, 0.0, 9);
+  const auto full = ppc::util::RandomBinaryImage<ppc::util::policy::Seq>(kWidth, kHeight, 1.0, 9);
+  EXPECT_EQ(std::count(empty.begin(), empty.end(), 1), 0);
+  EXPECT_EQ(std::count(full.begin(), full.end(), 1), static_cast<std::ptrdiff_t>(full.size()));
+}
+
+TEST(random_tests, check_points_follow_vector) {
+  const auto points = ppc::util::RandomPoints<ppc::util::policy::Seq, int, 3>(100, 0, 4095, 21);
+  const auto coordinates = ppc::util::RandomVector<ppc::util::policy::Seq>(size_t{300}, 0, 4095, 21);
+  for (size_t i = 0; i < points.size(); i++) {
+    for (size_t j = 0; j < 3; j++) {
+      EXPECT_EQ(points[i][j], coordinates[(i * 3) + j]);
+    }
+  }
+}
@@ -0,0 +1,157 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "core/util/include/ring_buffer.hpp"
+
+namespace {
+
+constexpr int kItems = 20000;
+
+template <typename Queue>
+std::vector<int> RunMpmc(Queue &queue, int producers, int consumers) {
+  const int per_producer = kItems / producers;
+  const int total = per_producer * producers;
+  std::vector<std::vector<int>> popped(consumers);
+  std::vector<std::thread> threads;
+  for (int p = 0; p < producers; p++) {
+    threads.emplace_back([&queue, p, per_producer] {
+      for (int i = 0; i < per_producer; i++) {
+        queue.Push((p * per_producer) + i);
+      }
+    });
+  }
+  for (int c = 0; c < consumers; c++) {
+    // every consumer pops its share, the last one the remainder
+    const int share = c + 1 < consumers ? total / consumers : total - ((total / consumers) * (consumers - 1));
+    threads.emplace_back([&queue, &popped, c, share] {
+      for (int i = 0; i < share; i++) {
+        popped[c].push_back(queue.Pop());
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  std::vector<int> all;
+  for (const auto &items : popped) {
+    all.insert(all.end(), items.begin(), items.end());
+  }
+  std::ranges::sort(all);
+  return all;
+}
+
+template <typename Queue>
+void CheckSpscOrder() {
+  Queue queue(16);
+  std::thread producer([&queue] {
+    for (int i = 0; i < kItems; i++) {
+      queue.Push(i);
+    }
+  });
+  bool in_order = true;
+  for (int i = 0; i < kItems; i++) {
+    in_order = in_order && queue.Pop() == i;
+  }
+  producer.join();
+
+  EXPECT_TRUE(in_order);
+}
+
+template <typename Queue>
+void CheckMpmcDeliversEveryItemOnce() {
+  Queue queue(8);
+  const auto popped = RunMpmc(queue, 3, 2);
+
+  ASSERT_EQ(popped.size(), static_cast<size_t>((kItems / 3) * 3));
+  for (size_t i = 0; i < popped.size(); i++) {
+    ASSERT_EQ(popped[i], static_cast<int>(i));
+  }
+}
+
+template <typename Queue>
+void CheckFullAndEmpty() {
+  Queue queue(3);
+  ASSERT_EQ(queue.Capacity(), 4U);
+
+  int value = -1;
+  EXPECT_FALSE(queue.TryPop(value));
+  for (int i = 0; i < 4; i++) {
+    EXPECT_TRUE(queue.TryPush(i));
+  }
+  EXPECT_FALSE(queue.TryPush(4));
+  for (int i = 0; i < 4; i++) {
+    ASSERT_TRUE(queue.TryPop(value));
+    EXPECT_EQ(value, i);
+  }
+  EXPECT_FALSE(queue.TryPop(value));
+  // the indices wrap around the ring
+  EXPECT_TRUE(queue.TryPush(5));
+  ASSERT_TRUE(queue.TryPop(value));
+  EXPECT_EQ(value, 5);
+}
+
+}  // namespace
+
+TEST(ring_buffer_tests, check_spsc_keeps_order_spinning) { CheckSpscOrder<ppc::util::SpscRingBuffer<int>>(); }
+
+TEST(ring_buffer_tests, check_spsc_keeps_order_blocking) {
+  CheckSpscOrder<ppc::util::SpscRingBuffer<int, ppc::util::BlockingWait>>();
+}
+
+TEST(ring_buffer_tests, check_mpmc_delivers_every_item_once_spinning) {
+  CheckMpmcDeliversEveryItemOnce<ppc::util::MpmcRingBuffer<int>>();
+}
+
+TEST(ring_buffer_tests, check_mpmc_delivers_every_item_once_blocking) {
+  CheckMpmcDeliversEveryItemOnce<ppc::util::MpmcRingBuffer<int, ppc::util::BlockingWait>>();
+}
+
+TEST(ring_buffer_tests, check_spsc_full_and_empty) { CheckFullAndEmpty<ppc::util::SpscRingBuffer<int>>(); }
+
+TEST(ring_buffer_tests, check_mpmc_full_and_empty) { CheckFullAndEmpty<ppc::util::MpmcRingBuffer<int>>(); }
+
+TEST(ring_buffer_tests, check_mpmc_keeps_order_of_one_producer) {
+  ppc::util::MpmcRingBuffer<int> queue(4);
+  std::thread producer([&queue] {
+    for (int i = 0; i < kItems; i++) {
+      queue.Push(i);
+    }
+  });
+  bool in_order = true;
+  for (int i = 0; i < kItems; i++) {
+    in_order = in_order && queue.Pop() == i;
+  }
+  producer.join();
+
+  EXPECT_TRUE(in_order);
+}
+
+TEST(ring_buffer_tests, check_capacity_one) {
+  ppc::util::SpscRingBuffer<int> spsc(1);
+  EXPECT_EQ(spsc.Capacity(), 1U);
+  EXPECT_TRUE(spsc.TryPush(1));
+  EXPECT_FALSE(spsc.TryPush(2));
+
+  // one slot cannot tell full from free in the sequence numbers: MPMC takes two
+  ppc::util::MpmcRingBuffer<int> mpmc(1);
+  ASSERT_EQ(mpmc.Capacity(), 2U);
+  EXPECT_TRUE(mpmc.TryPush(1));
+  EXPECT_TRUE(mpmc.TryPush(2));
+  EXPECT_FALSE(mpmc.TryPush(3));
+  int value = -1;
+  ASSERT_TRUE(mpmc.TryPop(value));
+  EXPECT_EQ(value, 1);
+  ASSERT_TRUE(mpmc.TryPop(value));
+  EXPECT_EQ(value, 2);
+  EXPECT_FALSE(mpmc.TryPop(value));
+}
+
+TEST(ring_buffer_tests, check_zero_capacity_throws) {
+  EXPECT_THROW(ppc::util::SpscRingBuffer<int>(0), std::invalid_argument);
+  EXPECT_THROW(ppc::util::MpmcRingBuffer<int>(0), std::invalid_argument);
+}
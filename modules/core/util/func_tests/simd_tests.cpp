@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "core/util/include/simd.hpp"
+
+namespace {
+
+// values with many repeats, so first-occurrence ties matter
+template <typename T>
+std::vector<T> Repeating(size_t n) {
+  std::vector<T> values(n);
+  for (size_t i = 0; i < n; i++) {
+    values[i] = static_cast<T>((i * 37) % 23);
+  }
+  return values;
+}
+
+template <typename T>
+void ExpectArgMinMaxLikeStd() {
+  const auto values = Repeating<T>(300);
+  for (size_t n = 1; n <= values.size(); n += 7) {
+    const auto min = ppc::util::ArgMin(values.data(), n);
+    const auto max = ppc::util::ArgMax(values.data(), n);
+    const auto *expected_min = std::min_element(values.data(), values.data() + n);
+    const auto *expected_max = std::max_element(values.data(), values.data() + n);
+    EXPECT_EQ(min.index, static_cast<size_t>(expected_min - values.data()));
+    EXPECT_EQ(min.value, *expected_min);
+    EXPECT_EQ(max.index, static_cast<size_t>(expected_max - values.data()));
+    EXPECT_EQ(max.value, *expected_max);
+  }
+}
+
+}  // namespace
+
+TEST(simd_tests, check_arithmetic_is_lane_wise) {
+  using Vec = ppc::util::Simd<int>;
+  const auto a = Vec::Iota(1);
+  const auto b = Vec::Broadcast(3);
+  const auto sum = a + b;
+  const auto product = a * b;
+  const auto fma = Fma(a, b, a);
+  for (size_t lane = 0; lane < Vec::kWidth; lane++) {
+    const int x = static_cast<int>(lane) + 1;
+    EXPECT_EQ(sum[lane], x + 3);
+    EXPECT_EQ(product[lane], x * 3);
+    EXPECT_EQ(fma[lane], (x * 3) + x);
+  }
+}
+
+TEST(simd_tests, check_fma_rounds_once) {
+  using Vec = ppc::util::Simd<double>;
+  // (1 + 2^-30)^2 - 1 keeps its 2^-60 only if the product is not rounded
+  const double x = 1.0 + 0x1p-30;
+  const auto result = Fma(Vec::Broadcast(x), Vec::Broadcast(x), Vec::Broadcast(-1.0));
+  EXPECT_EQ(result[0], 0x1p-29 + 0x1p-60);
+}
+
+TEST(simd_tests, check_aligned_and_unaligned_load_store) {
+  using Vec = ppc::util::Simd<float>;
+  alignas(Vec::kAlignment) std::array<float, 2 * Vec::kWidth> buffer{};
+  for (size_t i = 0; i < buffer.size(); i++) {
+    buffer[i] = static_cast<float>(i);
+  }
+  const auto aligned = Vec::Load(buffer.data());
+  const auto shifted = Vec::LoadUnaligned(buffer.data() + 1);
+  EXPECT_EQ(aligned[0], 0.0F);
+  EXPECT_EQ(shifted[0], 1.0F);
+
+  (aligned + shifted).Store(buffer.data() + Vec::kWidth);
+  EXPECT_EQ(buffer[Vec::kWidth], 1.0F);
+  aligned.StoreUnaligned(buffer.data() + 1);
+  EXPECT_EQ(buffer[1], 0.0F);
+}
+
+TEST(simd_tests, check_compare_masks) {
+  using Vec = ppc::util::Simd<float>;
+  const auto a = Vec::Iota(0.0F);
+  const auto mask = a < Vec::Broadcast(2.0F);
+  EXPECT_EQ(mask.Count(), 2U);
+  EXPECT_EQ(mask.Bits(), 0b11U);
+  EXPECT_TRUE(mask.Any());
+  EXPECT_FALSE(mask.All());
+  EXPECT_TRUE((mask | ~mask).All());
+  EXPECT_FALSE((mask & ~mask).Any());
+
+  const auto selected = Select(mask, a, Vec::Broadcast(-1.0F));
+  EXPECT_EQ(selected[1], 1.0F);
+  EXPECT_EQ(selected[2], -1.0F);
+}
+
+TEST(simd_tests, check_horizontal_reductions) {
+  using Vec = ppc::util::Simd<int64_t>;
+  const auto a = Vec::Iota(5);
+  const auto last = static_cast<int64_t>(4 + Vec::kWidth);
+  EXPECT_EQ(a.ReduceAdd(), (5 + last) * static_cast<int64_t>(Vec::kWidth) / 2);
+  EXPECT_EQ(a.ReduceMin(), 5);
+  EXPECT_EQ(a.ReduceMax(), last);
+  EXPECT_EQ(Max(a, Vec::Broadcast(6)).ReduceMin(), 6);
+  EXPECT_EQ(Abs(Vec() - a).ReduceMax(), last);
+}
+
+TEST(simd_tests, check_convert_widens_lanes) {
+  using Vec = ppc::util::Simd<float>;
+  const auto wide = Vec::Iota(0.5F).Convert<double>();
+  EXPECT_EQ(decltype(wide)::kWidth, Vec::kWidth);
+  EXPECT_EQ(wide[Vec::kWidth - 1], static_cast<double>(Vec::kWidth) - 0.5);
+}
+
+TEST(simd_tests, check_argmin_argmax_int) { ExpectArgMinMaxLikeStd<int>(); }
+
+TEST(simd_tests, check_argmin_argmax_float) { ExpectArgMinMaxLikeStd<float>(); }
+
+TEST(simd_tests, check_argmin_argmax_double) { ExpectArgMinMaxLikeStd<double>(); }
+
+// int8_t blocks are counted in int8_t lanes, which restart every 127 blocks
+TEST(simd_tests, check_argmin_argmax_past_counter_range) {
+  std::vector<int8_t> values(5000, 0);
+  values[4321] = -7;
+  values[4900] = 9;
+  values[4901] = 9;
+  EXPECT_EQ(ppc::util::ArgMin(values.data(), values.size()).index, 4321U);
+  EXPECT_EQ(ppc::util::ArgMax(values.data(), values.size()).index, 4900U);
+  ExpectArgMinMaxLikeStd<int8_t>();
+}
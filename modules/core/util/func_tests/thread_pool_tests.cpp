@@ -0,0 +1,154 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "core/util/include/thread_pool.hpp"
+
+TEST(thread_pool_tests, check_parallel_for_covers_range) {
+  ppc::util::ThreadPool pool(4);
+  std::vector<int> hits(1000, 0);
+  pool.ParallelFor(10, hits.size(), [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+      hits[i]++;
+    }
+  });
+
+  EXPECT_TRUE(std::all_of(hits.begin(), hits.begin() + 10, [](int hit) { return hit == 0; }));
+  EXPECT_TRUE(std::all_of(hits.begin() + 10, hits.end(), [](int hit) { return hit == 1; }));
+}
+
+TEST(thread_pool_tests, check_grain_size) {
+  ppc::util::ThreadPool pool(3);
+  std::atomic<int> chunks = 0;
+  auto body = [&](size_t begin, size_t end) {
+    EXPECT_LE(end - begin, 7U);
+    chunks++;
+  };
+  pool.ParallelFor(0, 100, body, 7);
+
+  EXPECT_EQ(chunks.load(), 15);
+}
+
+TEST(thread_pool_tests, check_submit_and_wait) {
+  ppc::util::ThreadPool pool(2);
+  std::atomic<int> sum = 0;
+  for (int i = 1; i <= 100; i++) {
+    pool.Submit([&sum, i] { sum += i; });
+  }
+  pool.Wait();
+
+  EXPECT_EQ(sum.load(), 5050);
+}
+
+TEST(thread_pool_tests, check_nested_parallel_for) {
+  ppc::util::ThreadPool pool(2);
+  std::vector<long long> row_sums(16, 0);
+  auto rows = [&](size_t row_begin, size_t row_end) {
+    for (size_t row = row_begin; row < row_end; row++) {
+      std::atomic<long long> sum = 0;
+      auto columns = [&](size_t begin, size_t end) {
+        std::vector<long long> values(end - begin);
+        std::iota(values.begin(), values.end(), static_cast<long long>(begin));
+        sum += std::accumulate(values.begin(), values.end(), 0LL);
+      };
+      pool.ParallelFor(0, 1000, columns, 10);
+      row_sums[row] = sum;
+    }
+  };
+  pool.ParallelFor(0, row_sums.size(), rows, 1);
+
+  EXPECT_TRUE(std::all_of(row_sums.begin(), row_sums.end(), [](long long sum) { return sum == 499500; }));
+}
+
+TEST(thread_pool_tests, check_exceptions_are_rethrown) {
+  ppc::util::ThreadPool pool(2);
+  auto failing = [](size_t begin, size_t) {
+    if (begin == 5) {
+      throw std::runtime_error("chunk failed");
+    }
+  };
+  EXPECT_THROW(pool.ParallelFor(0, 10, failing, 1), std::runtime_error);
+
+  pool.Submit([] { throw std::runtime_error("job failed"); });
+  EXPECT_THROW(pool.Wait(), std::runtime_error);
+  // the error is reported once
+  EXPECT_NO_THROW(pool.Wait());
+}
+
+TEST(thread_pool_tests, check_global_pool_is_shared) {
+  auto &pool = ppc::util::ThreadPool::Global();
+  EXPECT_EQ(&pool, &ppc::util::ThreadPool::Global());
+  EXPECT_GE(pool.NumThreads(), 1);
+  // outside of a parallel call the slot of thread 0 is not held
+  EXPECT_EQ(pool.CurrentThreadIndex(), pool.NumThreads());
+
+  std::vector<int> indices(pool.NumThreads() * 8, -1);
+  auto record = [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+      indices[i] = pool.CurrentThreadIndex();
+    }
+  };
+  pool.ParallelFor(0, indices.size(), record, 1);
+  EXPECT_TRUE(std::all_of(indices.begin(), indices.end(),
+                          [&](int index) { return index >= 0 && index < pool.NumThreads(); }));
+}
+
+TEST(thread_pool_tests, check_concurrent_outside_callers) {
+  ppc::util::ThreadPool pool(2);
+  std::atomic<bool> first_inside = false;
+  std::atomic<bool> second_done = false;
+  int first_index = -1;
+  int second_outside_index = -1;
+  std::vector<int> second_indices;
+  std::mutex second_mutex;
+
+  std::thread first([&] {
+    const auto self = std::this_thread::get_id();
+    auto hold = [&](size_t, size_t) {
+      // the caller runs chunk 0 itself and keeps the slot of thread 0 meanwhile
+      if (std::this_thread::get_id() == self) {
+        first_index = pool.CurrentThreadIndex();
+        first_inside = true;
+        while (!second_done) {
+          std::this_thread::yield();
+        }
+      }
+    };
+    pool.ParallelFor(0, 2, hold, 1);
+  });
+  std::thread second([&] {
+    while (!first_inside) {
+      std::this_thread::yield();
+    }
+    const auto self = std::this_thread::get_id();
+    second_outside_index = pool.CurrentThreadIndex();
+    auto record = [&](size_t, size_t) {
+      if (std::this_thread::get_id() == self) {
+        std::lock_guard lock(second_mutex);
+        second_indices.push_back(pool.CurrentThreadIndex());
+      }
+    };
+    pool.ParallelFor(0, 64, record, 1);
+    second_done = true;
+  });
+  first.join();
+  second.join();
+
+  EXPECT_EQ(first_index, 0);
+  EXPECT_EQ(second_outside_index, pool.NumThreads());
+  ASSERT_FALSE(second_indices.empty());
+  for (int index : second_indices) {
+    EXPECT_EQ(index, pool.NumThreads());
+  }
+}
+
+TEST(thread_pool_tests, check_invalid_size_throws) {
+  EXPECT_THROW(ppc::util::ThreadPool(0), std::invalid_argument);
+}
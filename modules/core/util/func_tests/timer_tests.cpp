@@ -0,0 +1,55 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <stdexcept>
+#include <thread>
+
+#include "core/util/include/timer.hpp"
+
+TEST(timer_tests, check_calibration) {
+  const auto &calibration = ppc::util::GetTimerCalibration();
+  EXPECT_GT(calibration.seconds_per_tick, 0.0);
+  // no counter ticks slower than 1 MHz or faster than 100 GHz
+  EXPECT_LE(calibration.seconds_per_tick, 1e-6);
+  EXPECT_GE(calibration.seconds_per_tick, 1e-11);
+  EXPECT_FALSE(ppc::util::TimerSourceName(calibration.source).empty());
+}
+
+TEST(timer_tests, check_now_is_monotonic) {
+  double previous = ppc::util::NowSeconds();
+  EXPECT_GE(previous, 0.0);
+  for (int i = 0; i < 10000; i++) {
+    const double now = ppc::util::NowSeconds();
+    ASSERT_GE(now, previous);
+    previous = now;
+  }
+}
+
+TEST(timer_tests, check_agrees_with_steady_clock) {
+  const auto steady_begin = std::chrono::steady_clock::now();
+  const double begin = ppc::util::NowSeconds();
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  const double end = ppc::util::NowSeconds();
+  const double steady = std::chrono::duration<double>(std::chrono::steady_clock::now() - steady_begin).count();
+
+  EXPECT_NEAR(end - begin, steady, 0.05 * steady);
+}
+
+TEST(timer_tests, check_ticks_to_seconds) {
+  const auto &calibration = ppc::util::GetTimerCalibration();
+  EXPECT_DOUBLE_EQ(ppc::util::TicksToSeconds(1000), 1000 * calibration.seconds_per_tick);
+  EXPECT_DOUBLE_EQ(ppc::util::TicksToSeconds(-1000), -1000 * calibration.seconds_per_tick);
+}
+
+TEST(timer_tests, check_environment_selects_source) {
+  setenv("PPC_TIMER", "steady", 1);  // NOLINT(misc-include-cleaner)
+  const auto steady = ppc::util::CalibrateTimer();
+  EXPECT_EQ(steady.source, ppc::util::TimerSource::kSteady);
+  EXPECT_DOUBLE_EQ(steady.seconds_per_tick, 1e-9);
+
+  setenv("PPC_TIMER", "hpet", 1);  // NOLINT(misc-include-cleaner)
+  EXPECT_THROW(ppc::util::CalibrateTimer(), std::invalid_argument);
+  unsetenv("PPC_TIMER");  // NOLINT(misc-include-cleaner)
+}
@@ -1,6 +1,9 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdlib>
+#include <stdexcept>
 #include <string>
 #include <thread>
 
@@ -11,8 +14,9 @@ TEST(util_tests, check_unset_env) {
   int save_var = ppc::util::GetPPCNumThreads();
 
   unsetenv("OMP_NUM_THREADS");  // NOLINT(misc-include-cleaner)
+  unsetenv("PPC_NUM_THREADS");  // NOLINT(misc-include-cleaner)
 
-  EXPECT_EQ(ppc::util::GetPPCNumThreads(), 1);
+  EXPECT_EQ(ppc::util::GetPPCNumThreads(), ppc::util::GetUsableCpuCount());
 
   setenv("OMP_NUM_THREADS", std::to_string(save_var).c_str(), 1);  // NOLINT(misc-include-cleaner)
 #else
@@ -34,3 +38,48 @@ TEST(util_tests, check_set_env) {
   GTEST_SKIP();
 #endif
 }
+
+TEST(util_tests, check_override_env) {
+#ifndef _WIN32
+  int save_var = ppc::util::GetPPCNumThreads();
+
+  setenv("OMP_NUM_THREADS", "2,1", 1);  // NOLINT(misc-include-cleaner)
+  EXPECT_EQ(ppc::util::GetPPCNumThreads(), 2);
+  setenv("PPC_NUM_THREADS", " 3 ", 1);  // NOLINT(misc-include-cleaner)
+  EXPECT_EQ(ppc::util::GetPPCNumThreads(), 3);
+
+  unsetenv("PPC_NUM_THREADS");                                     // NOLINT(misc-include-cleaner)
+  setenv("OMP_NUM_THREADS", std::to_string(save_var).c_str(), 1);  // NOLINT(misc-include-cleaner)
+#else
+  GTEST_SKIP();
+#endif
+}
+
+TEST(util_tests, check_malformed_env_throws) {
+#ifndef _WIN32
+  for (const char *value : {"abc", "0", "-2", "4x", "99999999999"}) {
+    setenv("PPC_NUM_THREADS", value, 1);  // NOLINT(misc-include-cleaner)
+    EXPECT_THROW(ppc::util::GetPPCNumThreads(), std::invalid_argument) << value;
+  }
+  unsetenv("PPC_NUM_THREADS");  // NOLINT(misc-include-cleaner)
+#else
+  GTEST_SKIP();
+#endif
+}
+
+TEST(util_tests, check_usable_cpu_count) {
+  const int cpus = ppc::util::GetUsableCpuCount();
+  EXPECT_GE(cpus, 1);
+  EXPECT_LE(cpus, std::max(1, static_cast<int>(std::thread::hardware_concurrency())));
+  const int quota = ppc::util::GetCgroupCpuLimit();
+  EXPECT_GE(quota, 0);
+  if (quota > 0) {
+    EXPECT_LE(cpus, quota);
+  }
+}
+
+TEST(util_tests, check_cache_sizes) {
+  const size_t llc = ppc::util::GetLastLevelCacheSize();
+  EXPECT_GE(llc, ppc::util::GetCacheSize(1));
+  EXPECT_EQ(ppc::util::GetCacheSize(0), 0U);
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Thread placement shared by the OpenMP, TBB and std::thread backends, so that
+// their results are comparable: a policy maps thread i of a team to a CPU,
+// each backend pins its threads accordingly and records where they ended up.
+// The policy comes from PPC_AFFINITY ("compact", "scatter" or a CPU list such
+// as "0,2,4-7"); without it the runtimes place threads as they like. The TBB
+// backend lives in affinity_tbb.hpp.
+namespace ppc::util {
+
+enum class AffinityKind : uint8_t {
+  // leave the placement to the OS and the runtime
+  kNone,
+  // consecutive threads fill the SMT siblings of a core, then the cores of a package
+  kCompact,
+  // consecutive threads go to different packages, then to different cores,
+  // SMT siblings are used last
+  kScatter,
+  // thread i runs on cpus[i % cpus.size()]
+  kExplicit,
+};
+
+struct AffinityPolicy {
+  AffinityKind kind = AffinityKind::kNone;
+  std::vector<int> cpus;
+
+  // "none", "compact", "scatter" or a CPU list; throws std::invalid_argument
+  static AffinityPolicy Parse(const std::string &text);
+  // "none", "compact", "scatter" or "explicit"
+  [[nodiscard]] std::string Name() const;
+};
+
+// PPC_AFFINITY, kNone if unset or empty; throws std::invalid_argument if malformed
+AffinityPolicy GetAffinityPolicy();
+
+// Position of a CPU in the machine
+struct CpuLocation {
+  int cpu = 0;
+  int package = 0;
+  int core = 0;
+};
+
+// CPUs of the affinity mask of the process with their package and core ids
+std::vector<CpuLocation> GetCpuTopology();
+// Package and core ids of the given CPUs
+std::vector<CpuLocation> GetCpuTopology(const std::vector<int> &cpus);
+
+// CPU of each of `num_threads` threads under the policy (empty for kNone);
+// threads beyond the number of CPUs wrap around
+std::vector<int> PlanPlacement(const AffinityPolicy &policy, int num_threads, const std::vector<CpuLocation> &cpus);
+
+// Restrict the calling thread / a std::thread to one CPU (Linux only); false
+// if the CPU is not available or pinning is not supported
+bool PinCurrentThread(int cpu);
+bool PinThread(std::thread &thread, int cpu);
+// Restrict the calling thread, and the threads it starts afterwards, to a set of CPUs
+bool RestrictCurrentThread(const std::vector<int> &cpus);
+
+// Share of process `local_rank` of the `local_size` processes of a node in its
+// CPUs: contiguous slices in compact order whose sizes differ by one at most,
+// so no two processes share a CPU unless there are more processes than CPUs
+std::vector<int> PartitionCpus(const std::vector<CpuLocation> &node_cpus, int local_rank, int local_size);
+
+// Remember the placement a backend ("omp", "tbb", "stl") applied: the CPU of
+// each thread, -1 where pinning failed
+void RecordPlacement(const std::string &backend, const AffinityPolicy &policy, const std::vector<int> &cpus);
+// Recorded placements, e.g. "omp:compact[0,1,2,3] stl:scatter[0,2]"; empty if none
+std::string PlacementSummary();
+
+// Pin the threads of the OpenMP team of omp_get_max_threads() threads. libgomp
+// and libomp reuse the same threads for later teams of the same size, so the
+// placement holds for the parallel regions that follow; the calling thread is
+// thread 0 and stays pinned.
+inline void ApplyAffinityOpenMP(const AffinityPolicy &policy) {
+#ifdef _OPENMP
+  const auto placement = PlanPlacement(policy, omp_get_max_threads(), GetCpuTopology());
+  if (placement.empty()) {
+    return;
+  }
+  std::vector<int> pinned(placement.size(), -1);
+#pragma omp parallel num_threads(static_cast<int>(placement.size()))
+  {
+    const auto thread = static_cast<size_t>(omp_get_thread_num());
+    pinned[thread] = PinCurrentThread(placement[thread]) ? placement[thread] : -1;
+  }
+  RecordPlacement("omp", policy, pinned);
+#else
+  (void)policy;
+#endif
+}
+
+}  // namespace ppc::util
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+#include "core/util/include/affinity.hpp"
+#include "oneapi/tbb/task_arena.h"
+#include "oneapi/tbb/task_scheduler_observer.h"
+
+// TBB backend of the affinity policies, header-only so that the core library
+// stays TBB-free: include it from TBB tasks only.
+namespace ppc::util {
+
+// Pins every thread that enters the observed arena to the CPU of its arena
+// slot (this_task_arena::current_thread_index()) and records the placement as
+// "tbb". task_arena::constraints only select NUMA nodes and core types, so
+// the CPU-level policies are applied from the observer. Observes the arena of
+// the constructing thread, or `arena` if given; no-op for AffinityKind::kNone.
+class AffinityObserver : public oneapi::tbb::task_scheduler_observer {
+ public:
+  explicit AffinityObserver(const AffinityPolicy &policy)
+      : policy_(policy),
+        placement_(PlanPlacement(policy, oneapi::tbb::this_task_arena::max_concurrency(), GetCpuTopology())),
+        pinned_(placement_.size(), -1) {
+    if (!placement_.empty()) {
+      observe(true);
+    }
+  }
+  AffinityObserver(oneapi::tbb::task_arena &arena, const AffinityPolicy &policy)
+      : oneapi::tbb::task_scheduler_observer(arena),
+        policy_(policy),
+        placement_(PlanPlacement(policy, arena.max_concurrency(), GetCpuTopology())),
+        pinned_(placement_.size(), -1) {
+    if (!placement_.empty()) {
+      observe(true);
+    }
+  }
+  AffinityObserver(const AffinityObserver &) = delete;
+  AffinityObserver &operator=(const AffinityObserver &) = delete;
+  ~AffinityObserver() override { observe(false); }
+
+  void on_scheduler_entry(bool /*is_worker*/) override {
+    const int slot = oneapi::tbb::this_task_arena::current_thread_index();
+    if (slot < 0 || static_cast<size_t>(slot) >= placement_.size()) {
+      return;
+    }
+    const int cpu = placement_[slot];
+    const bool ok = PinCurrentThread(cpu);
+    std::lock_guard lock(mutex_);
+    pinned_[slot] = ok ? cpu : -1;
+    RecordPlacement("tbb", policy_, pinned_);
+  }
+
+ private:
+  AffinityPolicy policy_;
+  std::vector<int> placement_;
+  std::mutex mutex_;
+  // CPU of every arena slot a thread has entered so far
+  std::vector<int> pinned_;
+};
+
+}  // namespace ppc::util
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Runtime selection between variants of a kernel compiled for different
+// instruction sets: the build targets the baseline ISA, so one binary runs
+// everywhere and still uses AVX2 or AVX-512 where the CPU has them.
+namespace ppc::util {
+
+enum class IsaLevel : uint8_t {
+  kScalar,
+  // SSE4.2 and everything below it
+  kSse42,
+  // AVX2 with FMA
+  kAvx2,
+  // AVX-512 F, VL, BW and DQ
+  kAvx512,
+};
+
+inline constexpr size_t kIsaLevels = 4;
+
+// Best level the CPU and the OS support (x86 with GCC or Clang; kScalar elsewhere)
+IsaLevel DetectIsaLevel();
+// Level kernels dispatch to: DetectIsaLevel() capped by PPC_ISA ("scalar",
+// "sse4.2", "avx2", "avx512") or by SetIsaLevel()
+IsaLevel GetIsaLevel();
+// Cap the dispatch level (at most DetectIsaLevel()), e.g. to compare variants
+// in tests and benchmarks; returns the previous level
+IsaLevel SetIsaLevel(IsaLevel level);
+
+// "scalar", "sse4.2", "avx2" or "avx512"
+std::string IsaName(IsaLevel level);
+// Inverse of IsaName(); throws std::invalid_argument
+IsaLevel ParseIsaLevel(const std::string &name);
+
+// Variants of one kernel indexed by IsaLevel, nullptr where a variant is not
+// compiled; the scalar one must exist
+template <typename Fn>
+class DispatchTable {
+ public:
+  explicit DispatchTable(const std::array<Fn *, kIsaLevels> &variants) : variants_(variants) {}
+
+  // the best variant not above `level`
+  [[nodiscard]] Fn *Select(IsaLevel level) const {
+    for (auto index = static_cast<size_t>(level); index > 0; index--) {
+      if (variants_[index] != nullptr) {
+        return variants_[index];
+      }
+    }
+    return variants_[0];
+  }
+  [[nodiscard]] Fn *Select() const { return Select(GetIsaLevel()); }
+
+ private:
+  std::array<Fn *, kIsaLevels> variants_;
+};
+
+}  // namespace ppc::util
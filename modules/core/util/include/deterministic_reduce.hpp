@@ -0,0 +1,92 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <vector>
+
+#include "core/util/include/kernels.hpp"
+#include "core/util/include/parallel.hpp"
+
+// Reductions whose result does not depend on the policy or the number of
+// threads: the range is cut into blocks of a fixed size, every block is reduced
+// in a fixed order (left to right, or in the lanes of a kernel of kernels.hpp)
+// and the block results are combined by a fixed pairwise tree.
+// Floating-point sums are therefore bitwise reproducible across backends, and
+// the tree keeps the rounding error at O(log n) blocks instead of O(n).
+namespace ppc::util {
+
+// elements per block; a block is the unit of work handed to a thread
+inline constexpr size_t kDeterministicBlock = 4096;
+
+namespace detail {
+
+template <typename T, typename Combine>
+T CombineTree(const std::vector<T> &values, size_t first, size_t last, Combine &combine) {
+  if (last - first == 1) {
+    return values[first];
+  }
+  const size_t middle = first + ((last - first) / 2);
+  return combine(CombineTree(values, first, middle, combine), CombineTree(values, middle, last, combine));
+}
+
+}  // namespace detail
+
+// reduce_block(begin, end) for every block of [0, n), combined by the fixed
+// tree; reduce_block must not depend on the thread it runs in
+template <typename Policy, typename T, typename ReduceBlock, typename Combine>
+T DeterministicBlockReduce(size_t n, T identity, ReduceBlock &&reduce_block, Combine &&combine,
+                           size_t block = kDeterministicBlock) {
+  if (n == 0) {
+    return identity;
+  }
+  block = std::max<size_t>(block, 1);
+  std::vector<T> partials((n + block - 1) / block, identity);
+  ParallelFor<Policy>(size_t{0}, partials.size(),
+                      [&](size_t b) { partials[b] = reduce_block(b * block, std::min(n, (b + 1) * block)); });
+  return detail::CombineTree(partials, 0, partials.size(), combine);
+}
+
+// combine over map(0), ..., map(n - 1) in a fixed shape; the result depends on
+// n and block only
+template <typename Policy, typename T, typename Map, typename Combine>
+T DeterministicReduce(size_t n, T identity, Map &&map, Combine &&combine, size_t block = kDeterministicBlock) {
+  auto reduce_block = [&](size_t begin, size_t end) {
+    T local = map(begin);
+    for (size_t i = begin + 1; i < end; ++i) {
+      local = combine(local, map(i));
+    }
+    return local;
+  };
+  return DeterministicBlockReduce<Policy>(n, identity, reduce_block, combine, block);
+}
+
+// map(0) + ... + map(n - 1) in a fixed order
+template <typename Policy, typename T, typename Map>
+T DeterministicSum(size_t n, Map &&map, size_t block = kDeterministicBlock) {
+  return DeterministicReduce<Policy>(n, T{0}, map, std::plus<T>(), block);
+}
+
+// Sum of the elements of a vector; float and double blocks are summed by the
+// vectorized SumBlock() kernel, whose lanes give the same bits on every CPU
+template <typename Policy, typename T>
+T DeterministicSum(const std::vector<T> &values, size_t block = kDeterministicBlock) {
+  if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>) {
+    auto sum_block = [&](size_t begin, size_t end) { return SumBlock(values.data() + begin, end - begin); };
+    return DeterministicBlockReduce<Policy>(values.size(), T{0}, sum_block, std::plus<T>(), block);
+  } else {
+    return DeterministicSum<Policy, T>(values.size(), [&](size_t i) { return values[i]; }, block);
+  }
+}
+
+// Dot product of two float or double vectors of the same size, accumulated in
+// double by the vectorized DotBlock() kernel
+template <typename Policy, typename T>
+double DeterministicDot(const std::vector<T> &x, const std::vector<T> &y, size_t block = kDeterministicBlock) {
+  static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>, "DeterministicDot needs float or double");
+  auto dot_block = [&](size_t begin, size_t end) { return DotBlock(x.data() + begin, y.data() + begin, end - begin); };
+  return DeterministicBlockReduce<Policy>(std::min(x.size(), y.size()), 0.0, dot_block, std::plus<double>(), block);
+}
+
+}  // namespace ppc::util
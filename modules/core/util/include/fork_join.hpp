@@ -0,0 +1,148 @@
+#pragma once
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+
+#include "core/util/include/parallel.hpp"
+#include "core/util/include/thread_pool.hpp"
+
+// Nested fork-join for divide-and-conquer kernels (merge sort, quickhull,
+// Strassen, recursive transposes) over the policies of parallel.hpp:
+//   void Sort(Range r) {
+//     ppc::util::ForkJoin<Policy>(r.size(), kCutoff, [&] { Sort(r.left()); }, [&] { Sort(r.right()); });
+//     Merge(r);
+//   }
+//   ppc::util::ForkJoinRoot<Policy>([&] { Sort(all); });
+// The TBB backend lives in fork_join_tbb.hpp.
+namespace ppc::util {
+
+// Spawn() starts a child that may run in parallel with the caller, Sync()
+// waits for all children of the group; the destructor syncs as well
+template <typename Policy>
+class TaskGroup;
+
+template <>
+class TaskGroup<policy::Seq> {
+ public:
+  template <typename F>
+  void Spawn(F &&f) {
+    f();
+  }
+  void Sync() {}
+};
+
+// Children are OpenMP tasks: they run in parallel inside ForkJoinRoot (or any
+// other parallel region) and inline outside of it. Sync() is a taskwait, it
+// waits for every child task of the current task. Exceptions must not leave
+// a child.
+template <>
+class TaskGroup<policy::OpenMP> {
+ public:
+  TaskGroup() = default;
+  TaskGroup(const TaskGroup &) = delete;
+  TaskGroup &operator=(const TaskGroup &) = delete;
+  ~TaskGroup() { Sync(); }
+
+  template <typename F>
+  void Spawn(F &&f) {
+    auto task = std::forward<F>(f);
+#ifdef _OPENMP
+#pragma omp task firstprivate(task)
+#endif
+    task();
+  }
+  void Sync() {
+#ifdef _OPENMP
+#pragma omp taskwait
+#endif
+  }
+};
+
+// Children are jobs of a work-stealing ThreadPool (the global one by default);
+// the thread in Sync() runs queued jobs while it waits, and the first exception
+// of a child is rethrown there
+template <>
+class TaskGroup<policy::StdThread> {
+ public:
+  explicit TaskGroup(ThreadPool &pool = ThreadPool::Global()) : pool_(pool) {}
+  TaskGroup(const TaskGroup &) = delete;
+  TaskGroup &operator=(const TaskGroup &) = delete;
+  ~TaskGroup() { pool_.HelpUntilZero(pending_); }
+
+  template <typename F>
+  void Spawn(F &&f) {
+    pending_.fetch_add(1, std::memory_order_relaxed);
+    pool_.Spawn([this, task = std::forward<F>(f)]() mutable {
+      try {
+        task();
+      } catch (...) {
+        std::lock_guard lock(error_mutex_);
+        if (!error_) {
+          error_ = std::current_exception();
+        }
+      }
+      pending_.fetch_sub(1, std::memory_order_release);
+    });
+  }
+  void Sync() {
+    pool_.HelpUntilZero(pending_);
+    std::exception_ptr error;
+    {
+      std::lock_guard lock(error_mutex_);
+      std::swap(error, error_);
+    }
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+
+ private:
+  ThreadPool &pool_;
+  std::atomic<size_t> pending_ = 0;
+  std::mutex error_mutex_;
+  std::exception_ptr error_;
+};
+
+// Enter the runtime of the policy and run the root of a recursion: OpenMP
+// starts a parallel region whose single thread runs `root` and the others
+// execute the spawned tasks; the other policies call `root` directly
+template <typename Policy, typename F>
+void ForkJoinRoot(F &&root) {
+  if constexpr (std::is_same_v<Policy, policy::OpenMP>) {
+#ifdef _OPENMP
+    if (!omp_in_parallel()) {
+#pragma omp parallel
+#pragma omp single
+      root();
+      return;
+    }
+#endif
+  }
+  root();
+}
+
+// `left` as a spawned child and `right` in the calling thread, then wait for
+// both; problems smaller than `cutoff` run both sequentially, so the recursion
+// pays for spawns only where there is enough work
+template <typename Policy, typename Left, typename Right>
+void ForkJoin(size_t size, size_t cutoff, Left &&left, Right &&right) {
+  if (size < cutoff) {
+    left();
+    right();
+    return;
+  }
+  TaskGroup<Policy> group;
+  group.Spawn(std::forward<Left>(left));
+  right();
+  group.Sync();
+}
+
+}  // namespace ppc::util
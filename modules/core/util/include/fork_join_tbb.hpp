@@ -0,0 +1,39 @@
+#pragma once
+
+#include <utility>
+
+#include "core/util/include/fork_join.hpp"
+#include "core/util/include/parallel_tbb.hpp"
+#include "oneapi/tbb/task_group.h"
+
+// TBB backend of TaskGroup, header-only so that the core library stays
+// TBB-free: include it from TBB tasks only.
+namespace ppc::util {
+
+// Children are tasks of a oneTBB task_group in the current arena; exceptions
+// of a child are rethrown by Sync()
+template <>
+class TaskGroup<policy::TBB> {
+ public:
+  TaskGroup() = default;
+  TaskGroup(const TaskGroup &) = delete;
+  TaskGroup &operator=(const TaskGroup &) = delete;
+  ~TaskGroup() {
+    // exceptions of children are reported by Sync() only
+    try {
+      group_.wait();
+    } catch (...) {
+    }
+  }
+
+  template <typename F>
+  void Spawn(F &&f) {
+    group_.run(std::forward<F>(f));
+  }
+  void Sync() { group_.wait(); }
+
+ private:
+  oneapi::tbb::task_group group_;
+};
+
+}  // namespace ppc::util
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Vectorized kernels of the reference reductions and of matrix multiplication,
+// compiled for every IsaLevel and dispatched at run time (cpu_dispatch.hpp).
+// All variants of a kernel compute the same operations in the same order, so
+// their results are bitwise identical on every machine (FmaPeak excepted).
+namespace ppc::util {
+
+// Lanes of the block reductions: element i is added to lane i % kKernelLanes,
+// the lanes are summed left to right and then combined pairwise
+inline constexpr size_t kKernelLanes = 32;
+
+// x[0] + ... + x[n - 1] in kKernelLanes lanes
+float SumBlock(const float *x, size_t n);
+double SumBlock(const double *x, size_t n);
+
+// x[0] * y[0] + ... + x[n - 1] * y[n - 1] in kKernelLanes lanes of doubles
+double DotBlock(const float *x, const float *y, size_t n);
+double DotBlock(const double *x, const double *y, size_t n);
+
+// Rows [row_begin, row_end) of c = a * b for row-major n x n matrices
+void GemmRows(const int *a, const int *b, int *c, size_t n, size_t row_begin, size_t row_end);
+void GemmRows(const float *a, const float *b, float *c, size_t n, size_t row_begin, size_t row_end);
+void GemmRows(const double *a, const double *b, double *c, size_t n, size_t row_begin, size_t row_end);
+
+// Probe of the FLOP roof: `iterations` rounds of independent double
+// multiply-add chains in the widest vectors of the level, with FMA where the
+// level has it. Returns the floating-point operations done; `sink` gets a
+// value depending on every chain.
+double FmaPeak(int64_t iterations, double &sink);
+
+}  // namespace ppc::util
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <set>
+#include <vector>
+
+#include "core/util/include/affinity.hpp"
+#include "core/util/include/util.hpp"
+
+// Node-aware split of the cores between MPI processes, header-only so that the
+// core library stays MPI-free: include it from MPI tasks only.
+namespace ppc::util {
+
+struct NodePartition {
+  // rank and number of the processes on the node of this process
+  int local_rank = 0;
+  int local_size = 1;
+  // CPUs of the node given to this process
+  std::vector<int> cpus;
+  // threads of every backend: GetPPCNumThreads() limited to the CPUs above and
+  // to this process's share of the cgroup CPU quota
+  int num_threads = 1;
+};
+
+// Collective over `comm`: finds the processes sharing a node with an
+// MPI_COMM_TYPE_SHARED split and divides the node's CPUs between them. If the
+// launcher already bound the processes to disjoint CPU sets, every process
+// keeps its own set; otherwise the union of their sets is cut into
+// PartitionCpus() slices.
+inline NodePartition PartitionNode(MPI_Comm comm = MPI_COMM_WORLD) {
+  int rank = 0;
+  MPI_Comm_rank(comm, &rank);
+  MPI_Comm node = MPI_COMM_NULL;
+  MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &node);
+
+  NodePartition partition;
+  MPI_Comm_rank(node, &partition.local_rank);
+  MPI_Comm_size(node, &partition.local_size);
+
+  std::vector<int> own;
+  for (const auto &location : GetCpuTopology()) {
+    own.push_back(location.cpu);
+  }
+  const int own_count = static_cast<int>(own.size());
+  std::vector<int> counts(partition.local_size);
+  MPI_Allgather(&own_count, 1, MPI_INT, counts.data(), 1, MPI_INT, node);
+  std::vector<int> displs(partition.local_size, 0);
+  for (int i = 1; i < partition.local_size; i++) {
+    displs[i] = displs[i - 1] + counts[i - 1];
+  }
+  std::vector<int> all(displs.back() + counts.back());
+  MPI_Allgatherv(own.data(), own_count, MPI_INT, all.data(), counts.data(), displs.data(), MPI_INT, node);
+  MPI_Comm_free(&node);
+
+  const std::set<int> node_cpus(all.begin(), all.end());
+  if (node_cpus.size() == all.size()) {
+    partition.cpus = own;
+  } else {
+    partition.cpus = PartitionCpus(GetCpuTopology({node_cpus.begin(), node_cpus.end()}), partition.local_rank,
+                                   partition.local_size);
+  }
+  // the cgroup quota is shared by the whole node like its CPUs
+  int usable = static_cast<int>(partition.cpus.size());
+  const int quota = GetCgroupCpuLimit();
+  if (quota > 0) {
+    usable = std::min(usable, std::max(1, quota / partition.local_size));
+  }
+  partition.num_threads = std::clamp(GetPPCNumThreads(), 1, usable);
+  return partition;
+}
+
+}  // namespace ppc::util
@@ -0,0 +1,256 @@
+#pragma once
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "core/util/include/thread_pool.hpp"
+
+// Backend-agnostic parallel loops: one kernel body compiles for every backend
+// by changing the policy tag, e.g.
+//   ppc::util::ParallelFor<ppc::util::policy::OpenMP>(0, n, [&](size_t i) { out[i] = f(in[i]); });
+// `grain` is the number of indices per chunk handed to a thread (0 - chosen
+// by the backend). The TBB backend lives in parallel_tbb.hpp, include it from
+// TBB tasks only so that the core library stays TBB-free.
+namespace ppc::util {
+
+namespace policy {
+// plain loop in the calling thread
+struct Seq {};
+// `omp parallel for`; sequential when compiled without OpenMP
+struct OpenMP {};
+// ThreadPool::Global()
+struct StdThread {};
+// oneTBB parallel_for / parallel_reduce (parallel_tbb.hpp)
+struct TBB {};
+}  // namespace policy
+
+// Implementation of the loops for one policy: static For, Reduce, NumWorkers
+// and WorkerIndex
+template <typename Policy>
+struct ParallelBackend;
+
+template <>
+struct ParallelBackend<policy::Seq> {
+  template <typename Index, typename Body>
+  static void For(Index begin, Index end, Body &body, size_t /*grain*/) {
+    for (Index i = begin; i < end; ++i) {
+      body(i);
+    }
+  }
+
+  template <typename Index, typename T, typename Map, typename Combine>
+  static T Reduce(Index begin, Index end, T identity, Map &map, Combine &combine, size_t /*grain*/) {
+    T result = identity;
+    for (Index i = begin; i < end; ++i) {
+      result = combine(result, map(i));
+    }
+    return result;
+  }
+
+  static int NumWorkers() { return 1; }
+  static int WorkerIndex() { return 0; }
+};
+
+template <>
+struct ParallelBackend<policy::OpenMP> {
+  // The loops over indices run in ordinary functions called once per chunk:
+  // compilers optimize them like sequential code, unlike loop bodies outlined
+  // into the parallel region.
+  template <typename Index, typename Body>
+  static void For(Index begin, Index end, Body &body, size_t grain) {
+    if (begin >= end) {
+      return;
+    }
+    const size_t chunk = ChunkSize(begin, end, grain);
+    const auto chunks = static_cast<int64_t>(ChunkCount(begin, end, chunk));
+    auto run_chunk = [&](int64_t c) {
+      const Index last = ChunkEnd(begin, end, chunk, c);
+      for (Index i = ChunkBegin(begin, chunk, c); i < last; ++i) {
+        body(i);
+      }
+    };
+    if (grain == 0) {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+      for (int64_t c = 0; c < chunks; ++c) {
+        run_chunk(c);
+      }
+    } else {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+      for (int64_t c = 0; c < chunks; ++c) {
+        run_chunk(c);
+      }
+    }
+  }
+
+  template <typename Index, typename T, typename Map, typename Combine>
+  static T Reduce(Index begin, Index end, T identity, Map &map, Combine &combine, size_t grain) {
+    if (begin >= end) {
+      return identity;
+    }
+    const size_t chunk = ChunkSize(begin, end, grain);
+    const auto chunks = static_cast<int64_t>(ChunkCount(begin, end, chunk));
+    auto reduce_chunk = [&](int64_t c, T local) {
+      const Index last = ChunkEnd(begin, end, chunk, c);
+      for (Index i = ChunkBegin(begin, chunk, c); i < last; ++i) {
+        local = combine(local, map(i));
+      }
+      return local;
+    };
+    // one partial result per thread, combined in thread order
+    std::vector<T> partials(NumWorkers(), identity);
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+      T local = identity;
+      if (grain == 0) {
+#ifdef _OPENMP
+#pragma omp for schedule(static) nowait
+#endif
+        for (int64_t c = 0; c < chunks; ++c) {
+          local = reduce_chunk(c, local);
+        }
+      } else {
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 1) nowait
+#endif
+        for (int64_t c = 0; c < chunks; ++c) {
+          local = reduce_chunk(c, local);
+        }
+      }
+      partials[WorkerIndex()] = local;
+    }
+    T result = identity;
+    for (const T &partial : partials) {
+      result = combine(result, partial);
+    }
+    return result;
+  }
+
+  static int NumWorkers() {
+#ifdef _OPENMP
+    return omp_get_max_threads();
+#else
+    return 1;
+#endif
+  }
+  static int WorkerIndex() {
+#ifdef _OPENMP
+    return omp_get_thread_num();
+#else
+    return 0;
+#endif
+  }
+
+ private:
+  // `grain` indices per chunk, or one chunk per thread
+  template <typename Index>
+  static size_t ChunkSize(Index begin, Index end, size_t grain) {
+    const auto count = static_cast<size_t>(end - begin);
+    const auto workers = static_cast<size_t>(NumWorkers());
+    return grain > 0 ? grain : std::max<size_t>(1, (count + workers - 1) / workers);
+  }
+  template <typename Index>
+  static size_t ChunkCount(Index begin, Index end, size_t chunk) {
+    return (static_cast<size_t>(end - begin) + chunk - 1) / chunk;
+  }
+  template <typename Index>
+  static Index ChunkBegin(Index begin, size_t chunk, int64_t c) {
+    return static_cast<Index>(begin + static_cast<Index>(static_cast<size_t>(c) * chunk));
+  }
+  template <typename Index>
+  static Index ChunkEnd(Index begin, Index end, size_t chunk, int64_t c) {
+    const auto offset = static_cast<size_t>(c + 1) * chunk;
+    return offset >= static_cast<size_t>(end - begin) ? end : static_cast<Index>(begin + static_cast<Index>(offset));
+  }
+};
+
+template <>
+struct ParallelBackend<policy::StdThread> {
+  template <typename Index, typename Body>
+  static void For(Index begin, Index end, Body &body, size_t grain) {
+    if (begin >= end) {
+      return;
+    }
+    const auto first = static_cast<size_t>(begin);
+    auto run_chunk = [&](size_t chunk_begin, size_t chunk_end) {
+      for (size_t i = chunk_begin; i < chunk_end; ++i) {
+        body(static_cast<Index>(first + i));
+      }
+    };
+    ThreadPool::Global().ParallelFor(0, static_cast<size_t>(end) - first, run_chunk, grain);
+  }
+
+  template <typename Index, typename T, typename Map, typename Combine>
+  static T Reduce(Index begin, Index end, T identity, Map &map, Combine &combine, size_t grain) {
+    if (begin >= end) {
+      return identity;
+    }
+    auto &pool = ThreadPool::Global();
+    const auto first = static_cast<size_t>(begin);
+    const size_t count = static_cast<size_t>(end) - first;
+    // the pool's default grain, fixed here to index the partial results by chunk
+    if (grain == 0) {
+      grain = std::max<size_t>(1, count / (4 * static_cast<size_t>(pool.NumThreads())));
+    }
+    std::vector<T> partials((count + grain - 1) / grain, identity);
+    auto reduce_chunk = [&](size_t chunk_begin, size_t chunk_end) {
+      T local = identity;
+      for (size_t i = chunk_begin; i < chunk_end; ++i) {
+        local = combine(local, map(static_cast<Index>(first + i)));
+      }
+      partials[chunk_begin / grain] = local;
+    };
+    pool.ParallelFor(0, count, reduce_chunk, grain);
+    T result = identity;
+    for (const T &partial : partials) {
+      result = combine(result, partial);
+    }
+    return result;
+  }
+
+  static int NumWorkers() { return ThreadPool::Global().NumThreads(); }
+  static int WorkerIndex() { return ThreadPool::Global().CurrentThreadIndex(); }
+};
+
+// body(i) for every i in [begin, end)
+template <typename Policy, typename Index, typename Body>
+void ParallelFor(Index begin, Index end, Body &&body, size_t grain = 0) {
+  static_assert(std::is_integral_v<Index>, "ParallelFor needs an integral index");
+  ParallelBackend<Policy>::For(begin, end, body, grain);
+}
+
+// combine(...combine(identity, map(i))...) over [begin, end); combine must be
+// associative, partial results are combined in an unspecified grouping
+template <typename Policy, typename Index, typename T, typename Map, typename Combine>
+T ParallelReduce(Index begin, Index end, T identity, Map &&map, Combine &&combine, size_t grain = 0) {
+  static_assert(std::is_integral_v<Index>, "ParallelReduce needs an integral index");
+  return ParallelBackend<Policy>::Reduce(begin, end, identity, map, combine, grain);
+}
+
+// Number of threads a loop of the policy runs on and the index of the calling
+// thread among them (for per-thread buffers and load-balance instrumentation).
+// StdThread gives NumWorkers() to an outside thread that helps the pool while
+// another one holds the slot of thread 0; ParallelRegion skips that index.
+template <typename Policy>
+int NumWorkers() {
+  return ParallelBackend<Policy>::NumWorkers();
+}
+
+template <typename Policy>
+int WorkerIndex() {
+  return ParallelBackend<Policy>::WorkerIndex();
+}
+
+}  // namespace ppc::util
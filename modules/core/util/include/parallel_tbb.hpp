@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+
+#include "core/util/include/parallel.hpp"
+#include "oneapi/tbb/blocked_range.h"
+#include "oneapi/tbb/parallel_for.h"
+#include "oneapi/tbb/parallel_reduce.h"
+#include "oneapi/tbb/partitioner.h"
+#include "oneapi/tbb/task_arena.h"
+
+// TBB backend of ParallelFor/ParallelReduce, header-only so that the core
+// library stays TBB-free: include it from TBB tasks only.
+namespace ppc::util {
+
+template <>
+struct ParallelBackend<policy::TBB> {
+  template <typename Index, typename Body>
+  static void For(Index begin, Index end, Body &body, size_t grain) {
+    auto run_range = [&](const oneapi::tbb::blocked_range<Index> &range) {
+      for (Index i = range.begin(); i < range.end(); ++i) {
+        body(i);
+      }
+    };
+    // a given grain is honored exactly, otherwise TBB splits adaptively
+    if (grain == 0) {
+      oneapi::tbb::parallel_for(oneapi::tbb::blocked_range<Index>(begin, end), run_range,
+                                oneapi::tbb::auto_partitioner());
+    } else {
+      oneapi::tbb::parallel_for(oneapi::tbb::blocked_range<Index>(begin, end, grain), run_range,
+                                oneapi::tbb::simple_partitioner());
+    }
+  }
+
+  template <typename Index, typename T, typename Map, typename Combine>
+  static T Reduce(Index begin, Index end, T identity, Map &map, Combine &combine, size_t grain) {
+    auto reduce_range = [&](const oneapi::tbb::blocked_range<Index> &range, T local) {
+      for (Index i = range.begin(); i < range.end(); ++i) {
+        local = combine(local, map(i));
+      }
+      return local;
+    };
+    if (grain == 0) {
+      return oneapi::tbb::parallel_reduce(oneapi::tbb::blocked_range<Index>(begin, end), identity, reduce_range,
+                                          combine, oneapi::tbb::auto_partitioner());
+    }
+    return oneapi::tbb::parallel_reduce(oneapi::tbb::blocked_range<Index>(begin, end, grain), identity, reduce_range,
+                                        combine, oneapi::tbb::simple_partitioner());
+  }
+
+  static int NumWorkers() { return oneapi::tbb::this_task_arena::max_concurrency(); }
+  static int WorkerIndex() { return oneapi::tbb::this_task_arena::current_thread_index(); }
+};
+
+}  // namespace ppc::util
@@ -0,0 +1,170 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "core/util/include/parallel.hpp"
+
+// Counter-based random inputs for tests: the value at position i is a function
+// of (seed, i) only, so generators fill large inputs in parallel with any
+// policy and thread count and still give the same bits.
+namespace ppc::util {
+
+using PhiloxBlock = std::array<uint32_t, 4>;
+using PhiloxKey = std::array<uint32_t, 2>;
+
+// Philox4x32-10 of Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3"
+constexpr PhiloxBlock Philox4x32(PhiloxBlock counter, PhiloxKey key) {
+  constexpr uint64_t kMul0 = 0xD2511F53;
+  constexpr uint64_t kMul1 = 0xCD9E8D57;
+  constexpr uint32_t kWeyl0 = 0x9E3779B9;
+  constexpr uint32_t kWeyl1 = 0xBB67AE85;
+  for (int round = 0; round < 10; round++) {
+    const uint64_t product0 = kMul0 * counter[0];
+    const uint64_t product1 = kMul1 * counter[2];
+    counter = {static_cast<uint32_t>(product1 >> 32) ^ counter[1] ^ key[0], static_cast<uint32_t>(product1),
+               static_cast<uint32_t>(product0 >> 32) ^ counter[3] ^ key[1], static_cast<uint32_t>(product0)};
+    key[0] += kWeyl0;
+    key[1] += kWeyl1;
+  }
+  return counter;
+}
+
+// Random stream keyed by the seed; independent streams of one seed differ in
+// `stream`
+class CounterRng {
+ public:
+  explicit constexpr CounterRng(uint64_t seed, uint64_t stream = 0)
+      : key_{static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)},
+        stream_{static_cast<uint32_t>(stream), static_cast<uint32_t>(stream >> 32)} {}
+
+  // 128 bits at position `block`
+  [[nodiscard]] constexpr PhiloxBlock Block(uint64_t block) const {
+    return Philox4x32({static_cast<uint32_t>(block), static_cast<uint32_t>(block >> 32), stream_[0], stream_[1]},
+                      key_);
+  }
+  // i-th 32 bits of the stream: word i % 4 of block i / 4
+  [[nodiscard]] constexpr uint32_t Word(uint64_t i) const { return Block(i / 4)[i % 4]; }
+  // i-th 64 bits of the stream: words 2i (low half) and 2i + 1
+  [[nodiscard]] constexpr uint64_t Bits64(uint64_t i) const {
+    const auto block = Block(i / 2);
+    const size_t word = 2 * (i % 2);
+    return (static_cast<uint64_t>(block[word + 1]) << 32) | block[word];
+  }
+
+ private:
+  PhiloxKey key_;
+  std::array<uint32_t, 2> stream_;
+};
+
+namespace detail {
+
+// high 64 bits of a * b
+constexpr uint64_t MulHi64(uint64_t a, uint64_t b) {
+  const uint64_t a_lo = a & 0xFFFFFFFFU;
+  const uint64_t a_hi = a >> 32;
+  const uint64_t b_lo = b & 0xFFFFFFFFU;
+  const uint64_t b_hi = b >> 32;
+  const uint64_t cross = ((a_lo * b_lo) >> 32) + ((a_hi * b_lo) & 0xFFFFFFFFU) + (a_lo * b_hi);
+  return (a_hi * b_hi) + ((a_hi * b_lo) >> 32) + (cross >> 32);
+}
+
+// random words per value of T: one for types of up to 4 bytes, two otherwise
+template <typename T>
+inline constexpr size_t kRandomWords = sizeof(T) <= 4 ? 1 : 2;
+
+// kRandomWords<T> random words mapped to [lo, hi]: multiply-shift for integers,
+// the top 24 or 53 bits as a fraction in [0, 1) for floating-point types
+template <typename T>
+constexpr T FromBits(uint64_t bits, T lo, T hi) {
+  constexpr bool kWide = kRandomWords<T> == 2;
+  if constexpr (std::is_integral_v<T>) {
+    using Unsigned = std::make_unsigned_t<T>;
+    const auto span = static_cast<Unsigned>(static_cast<Unsigned>(hi) - static_cast<Unsigned>(lo));
+    const uint64_t range = static_cast<uint64_t>(span) + 1;
+    uint64_t offset = 0;
+    if constexpr (kWide) {
+      offset = range == 0 ? bits : MulHi64(bits, range);
+    } else {
+      offset = (bits * range) >> 32;
+    }
+    return static_cast<T>(static_cast<Unsigned>(lo) + static_cast<Unsigned>(offset));
+  } else {
+    const double unit = kWide ? static_cast<double>(bits >> 11) * 0x1p-53 : static_cast<double>(bits >> 8) * 0x1p-24;
+    return static_cast<T>(static_cast<double>(lo) + ((static_cast<double>(hi) - static_cast<double>(lo)) * unit));
+  }
+}
+
+// elements per chunk of the parallel fills; the chunks split no Philox block
+inline constexpr size_t kRandomChunk = 4096;
+
+// store(i, bits) for i in [0, n) with bits = rng.Word(i) for kWords == 1 and
+// rng.Bits64(i) for kWords == 2, a chunk per thread at a time
+template <typename Policy, size_t kWords, typename Store>
+void ForEachRandom(size_t n, const CounterRng &rng, Store &&store) {
+  constexpr size_t kPerBlock = 4 / kWords;
+  ParallelFor<Policy>(size_t{0}, (n + kRandomChunk - 1) / kRandomChunk, [&](size_t chunk) {
+    const size_t end = std::min(n, (chunk + 1) * kRandomChunk);
+    for (size_t i = chunk * kRandomChunk; i < end; i += kPerBlock) {
+      const auto block = rng.Block(i / kPerBlock);
+      for (size_t j = 0; j < kPerBlock && i + j < end; j++) {
+        if constexpr (kWords == 1) {
+          store(i + j, block[j]);
+        } else {
+          store(i + j, (static_cast<uint64_t>(block[(2 * j) + 1]) << 32) | block[2 * j]);
+        }
+      }
+    }
+  });
+}
+
+}  // namespace detail
+
+// n values uniform in [lo, hi]
+template <typename Policy, typename T>
+std::vector<T> RandomVector(size_t n, T lo, T hi, uint64_t seed) {
+  static_assert(std::is_arithmetic_v<T>, "RandomVector needs an arithmetic type");
+  std::vector<T> values(n);
+  detail::ForEachRandom<Policy, detail::kRandomWords<T>>(
+      n, CounterRng(seed), [&](size_t i, uint64_t bits) { values[i] = detail::FromBits(bits, lo, hi); });
+  return values;
+}
+
+// rows x cols row-major matrix of values uniform in [lo, hi]; element (r, c)
+// does not depend on the shape beyond its row-major position
+template <typename Policy, typename T>
+std::vector<T> RandomMatrix(size_t rows, size_t cols, T lo, T hi, uint64_t seed) {
+  return RandomVector<Policy>(rows * cols, lo, hi, seed);
+}
+
+// width x height row-major image of 0 and 1 with a pixel set with probability
+// `density` (clamped to [0, 1])
+template <typename Policy>
+std::vector<uint8_t> RandomBinaryImage(size_t width, size_t height, double density, uint64_t seed) {
+  // a pixel is set when its random word is below density * 2^32
+  const auto threshold = static_cast<uint64_t>(std::ldexp(std::clamp(density, 0.0, 1.0), 32));
+  std::vector<uint8_t> image(width * height);
+  detail::ForEachRandom<Policy, 1>(image.size(), CounterRng(seed), [&](size_t i, uint64_t bits) {
+    image[i] = static_cast<uint8_t>(bits < threshold);
+  });
+  return image;
+}
+
+// n points with kDim coordinates uniform in [lo, hi]; coordinate j of point i
+// is element i * kDim + j of RandomVector with the same seed
+template <typename Policy, typename T, size_t kDim = 2>
+std::vector<std::array<T, kDim>> RandomPoints(size_t n, T lo, T hi, uint64_t seed) {
+  static_assert(std::is_arithmetic_v<T>, "RandomPoints needs an arithmetic type");
+  std::vector<std::array<T, kDim>> points(n);
+  detail::ForEachRandom<Policy, detail::kRandomWords<T>>(n * kDim, CounterRng(seed), [&](size_t i, uint64_t bits) {
+    points[i / kDim][i % kDim] = detail::FromBits(bits, lo, hi);
+  });
+  return points;
+}
+
+}  // namespace ppc::util
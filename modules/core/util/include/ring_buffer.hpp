@@ -0,0 +1,286 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Bounded lock-free queues for producer/consumer stage pipelines. Indices that
+// different threads write live on their own cache lines. TryPush/TryPop never
+// block; Push/Pop wait with the WaitStrategy of the queue.
+namespace ppc::util {
+
+inline constexpr size_t kCacheLineSize = 64;
+
+// Hint to the core that the thread is spinning
+inline void CpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__)
+  asm volatile("yield");
+#else
+  std::this_thread::yield();
+#endif
+}
+
+// Busy-waits (with pause, yielding the core now and then): lowest latency,
+// needs a core per waiting thread
+struct SpinWait {
+  template <typename T>
+  static void Wait(const std::atomic<T> &word, T old) {
+    for (uint32_t spins = 1; word.load(std::memory_order_acquire) == old; spins++) {
+      if (spins % 1024 == 0) {
+        std::this_thread::yield();
+      } else {
+        CpuRelax();
+      }
+    }
+  }
+  template <typename T>
+  static void Notify(std::atomic<T> & /*word*/) {}
+};
+
+// Spins briefly, then sleeps in std::atomic::wait until the other side
+// notifies: frees the core for oversubscribed pipelines at the cost of a
+// notification per operation
+struct BlockingWait {
+  static constexpr int kSpins = 64;
+
+  template <typename T>
+  static void Wait(const std::atomic<T> &word, T old) {
+    for (int spins = 0; spins < kSpins; spins++) {
+      if (word.load(std::memory_order_acquire) != old) {
+        return;
+      }
+      CpuRelax();
+    }
+    word.wait(old, std::memory_order_acquire);
+  }
+  template <typename T>
+  static void Notify(std::atomic<T> &word) {
+    word.notify_all();
+  }
+};
+
+namespace detail {
+
+// capacity rounded up to a power of two of at least min_capacity slots
+inline size_t RingCapacity(size_t capacity, size_t min_capacity = 1) {
+  if (capacity == 0) {
+    throw std::invalid_argument("ring buffer capacity must be positive");
+  }
+  return std::bit_ceil(std::max(capacity, min_capacity));
+}
+
+}  // namespace detail
+
+// Single producer, single consumer: one thread pushes and one thread pops.
+// The capacity is rounded up to a power of two; T must be default-constructible.
+template <typename T, typename WaitStrategy = SpinWait>
+class SpscRingBuffer {
+ public:
+  explicit SpscRingBuffer(size_t capacity)
+      : mask_(detail::RingCapacity(capacity) - 1), slots_(std::make_unique<T[]>(mask_ + 1)) {}
+
+  [[nodiscard]] size_t Capacity() const { return mask_ + 1; }
+
+  template <typename U>
+  bool TryPush(U &&value) {
+    const uint64_t tail = producer_.tail.load(std::memory_order_relaxed);
+    if (tail - producer_.head_cache == Capacity()) {
+      producer_.head_cache = consumer_.head.load(std::memory_order_acquire);
+      if (tail - producer_.head_cache == Capacity()) {
+        return false;
+      }
+    }
+    slots_[tail & mask_] = std::forward<U>(value);
+    producer_.tail.store(tail + 1, std::memory_order_release);
+    WaitStrategy::Notify(producer_.tail);
+    return true;
+  }
+
+  bool TryPop(T &value) {
+    const uint64_t head = consumer_.head.load(std::memory_order_relaxed);
+    if (head == consumer_.tail_cache) {
+      consumer_.tail_cache = producer_.tail.load(std::memory_order_acquire);
+      if (head == consumer_.tail_cache) {
+        return false;
+      }
+    }
+    value = std::move(slots_[head & mask_]);
+    consumer_.head.store(head + 1, std::memory_order_release);
+    WaitStrategy::Notify(consumer_.head);
+    return true;
+  }
+
+  template <typename U>
+  void Push(U &&value) {
+    while (!TryPush(std::forward<U>(value))) {
+      // full: wait until the consumer moves its head past the cached one
+      WaitStrategy::Wait(consumer_.head, producer_.head_cache);
+    }
+  }
+
+  T Pop() {
+    T value;
+    while (!TryPop(value)) {
+      WaitStrategy::Wait(producer_.tail, consumer_.tail_cache);
+    }
+    return value;
+  }
+
+ private:
+  // written by the producer; head_cache saves reading the consumer's line
+  struct alignas(kCacheLineSize) Producer {
+    std::atomic<uint64_t> tail = 0;
+    uint64_t head_cache = 0;
+  };
+  struct alignas(kCacheLineSize) Consumer {
+    std::atomic<uint64_t> head = 0;
+    uint64_t tail_cache = 0;
+  };
+
+  Producer producer_;
+  Consumer consumer_;
+  const uint64_t mask_;
+  std::unique_ptr<T[]> slots_;
+};
+
+// Multiple producers, multiple consumers (bounded queue of D. Vyukov): every
+// slot carries a sequence number telling whose turn it is, so producers and
+// consumers claim slots with one CAS each and never touch a shared lock.
+// The capacity is rounded up to a power of two of at least 2: with one slot
+// "full at pos" and "free for pos + 1" would be the same sequence number.
+// T must be default-constructible.
+template <typename T, typename WaitStrategy = SpinWait>
+class MpmcRingBuffer {
+ public:
+  explicit MpmcRingBuffer(size_t capacity) : mask_(detail::RingCapacity(capacity, 2) - 1), slots_(mask_ + 1) {
+    for (uint64_t i = 0; i <= mask_; i++) {
+      slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  [[nodiscard]] size_t Capacity() const { return mask_ + 1; }
+
+  template <typename U>
+  bool TryPush(U &&value) {
+    uint64_t sequence = 0;
+    Slot *slot = ClaimForPush(sequence);
+    if (slot == nullptr) {
+      return false;
+    }
+    Publish(*slot, std::forward<U>(value), sequence + 1);
+    return true;
+  }
+
+  bool TryPop(T &value) {
+    uint64_t sequence = 0;
+    Slot *slot = ClaimForPop(sequence);
+    if (slot == nullptr) {
+      return false;
+    }
+    Release(*slot, value, sequence + mask_);
+    return true;
+  }
+
+  template <typename U>
+  void Push(U &&value) {
+    uint64_t sequence = 0;
+    Slot *slot = nullptr;
+    while ((slot = ClaimForPush(sequence)) == nullptr) {
+      // full: the slot still holds the value pushed one lap earlier, wait
+      // until its consumer releases it
+      WaitStrategy::Wait(slots_[sequence & mask_].sequence, sequence - mask_);
+    }
+    Publish(*slot, std::forward<U>(value), sequence + 1);
+  }
+
+  T Pop() {
+    T value;
+    uint64_t sequence = 0;
+    Slot *slot = nullptr;
+    while ((slot = ClaimForPop(sequence)) == nullptr) {
+      // empty: the slot is still free, wait until a producer publishes into it
+      WaitStrategy::Wait(slots_[sequence & mask_].sequence, sequence);
+    }
+    Release(*slot, value, sequence + mask_);
+    return value;
+  }
+
+ private:
+  struct Slot {
+    std::atomic<uint64_t> sequence;
+    T value;
+  };
+  struct alignas(kCacheLineSize) Position {
+    std::atomic<uint64_t> position = 0;
+  };
+
+  // a slot is free for the push number `pos` when its sequence equals pos;
+  // returns nullptr with `pos` set to the position found full
+  Slot *ClaimForPush(uint64_t &pos) {
+    pos = enqueue_.position.load(std::memory_order_relaxed);
+    while (true) {
+      Slot &slot = slots_[pos & mask_];
+      const auto diff =
+          static_cast<int64_t>(slot.sequence.load(std::memory_order_acquire)) - static_cast<int64_t>(pos);
+      if (diff == 0) {
+        if (enqueue_.position.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          return &slot;
+        }
+      } else if (diff < 0) {
+        return nullptr;
+      } else {
+        pos = enqueue_.position.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // a slot holds the value of the pop number `pos` when its sequence is pos + 1;
+  // returns nullptr with `pos` set to the position found empty
+  Slot *ClaimForPop(uint64_t &pos) {
+    pos = dequeue_.position.load(std::memory_order_relaxed);
+    while (true) {
+      Slot &slot = slots_[pos & mask_];
+      const auto diff =
+          static_cast<int64_t>(slot.sequence.load(std::memory_order_acquire)) - static_cast<int64_t>(pos + 1);
+      if (diff == 0) {
+        if (dequeue_.position.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          return &slot;
+        }
+      } else if (diff < 0) {
+        return nullptr;
+      } else {
+        pos = dequeue_.position.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  template <typename U>
+  void Publish(Slot &slot, U &&value, uint64_t sequence) {
+    slot.value = std::forward<U>(value);
+    slot.sequence.store(sequence, std::memory_order_release);
+    WaitStrategy::Notify(slot.sequence);
+  }
+
+  // the slot becomes free for the push one lap (capacity positions) later
+  void Release(Slot &slot, T &value, uint64_t sequence) {
+    value = std::move(slot.value);
+    slot.sequence.store(sequence + 1, std::memory_order_release);
+    WaitStrategy::Notify(slot.sequence);
+  }
+
+  Position enqueue_;
+  Position dequeue_;
+  const uint64_t mask_;
+  std::vector<Slot> slots_;
+};
+
+}  // namespace ppc::util
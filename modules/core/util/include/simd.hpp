@@ -0,0 +1,405 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <type_traits>
+
+// Fixed-width SIMD vectors for the reference tasks and the kernels. With GCC
+// and Clang they are vector extensions, so the instructions follow the target
+// of the function using them: SSE by default, AVX2 or AVX-512 under -march or
+// a target attribute (see kernels.cpp). Other compilers, or PPC_SIMD_SCALAR,
+// get plain loops over the lanes. Every operation is lane-wise and reductions
+// fold the lanes in a fixed order, so a width gives the same bits on every
+// instruction set.
+namespace ppc::util {
+
+// Width of the widest vector registers enabled for this translation unit
+#if defined(__AVX512F__)
+inline constexpr size_t kSimdBytes = 64;
+#elif defined(__AVX__)
+inline constexpr size_t kSimdBytes = 32;
+#else
+inline constexpr size_t kSimdBytes = 16;
+#endif
+
+namespace detail {
+
+template <size_t kLaneBytes>
+struct SignedOfSize;
+template <>
+struct SignedOfSize<1> {
+  using Type = int8_t;
+};
+template <>
+struct SignedOfSize<2> {
+  using Type = int16_t;
+};
+template <>
+struct SignedOfSize<4> {
+  using Type = int32_t;
+};
+template <>
+struct SignedOfSize<8> {
+  using Type = int64_t;
+};
+
+// lanes of a mask: all bits set where the comparison holds
+template <size_t kLaneBytes>
+using MaskLane = typename SignedOfSize<kLaneBytes>::Type;
+
+#if (defined(__GNUC__) || defined(__clang__)) && !defined(PPC_SIMD_SCALAR)
+
+template <typename T, size_t kBytes>
+struct SimdStorage {
+  using Type __attribute__((vector_size(kBytes))) = T;
+};
+
+// the helpers write through references: vectors passed by value would
+// depend on the ABI of the target
+template <typename M, typename V>
+inline void Blend(V &result, const M &mask, const V &a, const V &b) {
+  result = mask ? a : b;
+}
+
+template <typename To, typename From>
+inline void ConvertLanes(To &result, const From &from) {
+  result = __builtin_convertvector(from, To);
+}
+
+#else
+
+// lane-wise operators of the vector extensions over an array
+template <typename T, size_t kBytes>
+struct LaneArray {
+  static constexpr size_t kWidth = kBytes / sizeof(T);
+  using Lane = T;
+  using Mask = LaneArray<MaskLane<sizeof(T)>, kBytes>;
+
+  std::array<T, kWidth> lanes;
+
+  T &operator[](size_t lane) { return lanes[lane]; }
+  const T &operator[](size_t lane) const { return lanes[lane]; }
+
+  template <typename Op>
+  friend LaneArray Map(const LaneArray &a, const LaneArray &b, Op op) {
+    LaneArray result;
+    for (size_t lane = 0; lane < kWidth; lane++) {
+      result[lane] = static_cast<T>(op(a[lane], b[lane]));
+    }
+    return result;
+  }
+  template <typename Op>
+  friend Mask Compare(const LaneArray &a, const LaneArray &b, Op op) {
+    Mask result;
+    for (size_t lane = 0; lane < kWidth; lane++) {
+      result[lane] = op(a[lane], b[lane]) ? -1 : 0;
+    }
+    return result;
+  }
+
+  friend LaneArray operator+(const LaneArray &a, const LaneArray &b) { return Map(a, b, std::plus<>()); }
+  friend LaneArray operator-(const LaneArray &a, const LaneArray &b) { return Map(a, b, std::minus<>()); }
+  friend LaneArray operator*(const LaneArray &a, const LaneArray &b) { return Map(a, b, std::multiplies<>()); }
+  friend LaneArray operator/(const LaneArray &a, const LaneArray &b) { return Map(a, b, std::divides<>()); }
+  friend LaneArray operator&(const LaneArray &a, const LaneArray &b) { return Map(a, b, std::bit_and<>()); }
+  friend LaneArray operator|(const LaneArray &a, const LaneArray &b) { return Map(a, b, std::bit_or<>()); }
+  friend LaneArray operator~(const LaneArray &a) { return Map(a, a, [](T x, T) { return ~x; }); }
+  friend Mask operator==(const LaneArray &a, const LaneArray &b) { return Compare(a, b, std::equal_to<>()); }
+  friend Mask operator!=(const LaneArray &a, const LaneArray &b) { return Compare(a, b, std::not_equal_to<>()); }
+  friend Mask operator<(const LaneArray &a, const LaneArray &b) { return Compare(a, b, std::less<>()); }
+  friend Mask operator<=(const LaneArray &a, const LaneArray &b) { return Compare(a, b, std::less_equal<>()); }
+  friend Mask operator>(const LaneArray &a, const LaneArray &b) { return Compare(a, b, std::greater<>()); }
+  friend Mask operator>=(const LaneArray &a, const LaneArray &b) { return Compare(a, b, std::greater_equal<>()); }
+};
+
+template <typename T, size_t kBytes>
+struct SimdStorage {
+  using Type = LaneArray<T, kBytes>;
+};
+
+template <typename M, typename V>
+inline void Blend(V &result, const M &mask, const V &a, const V &b) {
+  for (size_t lane = 0; lane < V::kWidth; lane++) {
+    result[lane] = mask[lane] != 0 ? a[lane] : b[lane];
+  }
+}
+
+template <typename To, typename From>
+inline void ConvertLanes(To &result, const From &from) {
+  for (size_t lane = 0; lane < From::kWidth; lane++) {
+    result[lane] = static_cast<typename To::Lane>(from[lane]);
+  }
+}
+
+#endif
+
+// pairwise fold of the lanes: lane 0 op= lane width / 2, ..., down to lane 0
+template <typename T, size_t kWidth, typename Op>
+T FoldLanes(std::array<T, kWidth> lanes, Op op) {
+  for (size_t width = kWidth / 2; width > 0; width /= 2) {
+    for (size_t lane = 0; lane < width; lane++) {
+      lanes[lane] = op(lanes[lane], lanes[lane + width]);
+    }
+  }
+  return lanes[0];
+}
+
+}  // namespace detail
+
+template <typename T, size_t kBytes>
+class Simd;
+
+// Result of a lane-wise comparison of Simd vectors with kLaneBytes lanes;
+// vectors of the same lane size (float and int32_t) share masks
+template <size_t kLaneBytes, size_t kBytes>
+class SimdMask {
+ public:
+  static constexpr size_t kWidth = kBytes / kLaneBytes;
+  using Storage = typename detail::SimdStorage<detail::MaskLane<kLaneBytes>, kBytes>::Type;
+
+  SimdMask() : v_{} {}
+  explicit SimdMask(const Storage &v) : v_(v) {}
+
+  [[nodiscard]] bool operator[](size_t lane) const { return v_[lane] != 0; }
+  [[nodiscard]] const Storage &Native() const { return v_; }
+
+  // bit i set where lane i is
+  [[nodiscard]] uint64_t Bits() const {
+    uint64_t bits = 0;
+    for (size_t lane = 0; lane < kWidth; lane++) {
+      bits |= static_cast<uint64_t>(v_[lane] != 0) << lane;
+    }
+    return bits;
+  }
+  [[nodiscard]] size_t Count() const {
+    size_t count = 0;
+    for (size_t lane = 0; lane < kWidth; lane++) {
+      count += static_cast<size_t>(v_[lane] != 0);
+    }
+    return count;
+  }
+  [[nodiscard]] bool Any() const { return Bits() != 0; }
+  [[nodiscard]] bool All() const { return Count() == kWidth; }
+
+  friend SimdMask operator&(const SimdMask &a, const SimdMask &b) { return SimdMask(a.v_ & b.v_); }
+  friend SimdMask operator|(const SimdMask &a, const SimdMask &b) { return SimdMask(a.v_ | b.v_); }
+  friend SimdMask operator~(const SimdMask &a) { return SimdMask(~a.v_); }
+
+ private:
+  Storage v_;
+};
+
+// kBytes / sizeof(T) lanes of an arithmetic T; default-constructed to zeros
+template <typename T, size_t kBytes = kSimdBytes>
+class Simd {
+  static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool> && sizeof(T) <= 8,
+                "Simd lanes are integers or floating-point numbers of at most 8 bytes");
+  static_assert(kBytes % sizeof(T) == 0 && std::has_single_bit(kBytes / sizeof(T)),
+                "Simd needs a power of two number of lanes");
+
+ public:
+  static constexpr size_t kWidth = kBytes / sizeof(T);
+  // alignment Load() and Store() need
+  static constexpr size_t kAlignment = kBytes;
+  using Storage = typename detail::SimdStorage<T, kBytes>::Type;
+  using Mask = SimdMask<sizeof(T), kBytes>;
+
+  Simd() : v_{} {}
+  explicit Simd(const Storage &v) : v_(v) {}
+
+  static Simd Broadcast(T value) {
+    Simd result;
+    for (size_t lane = 0; lane < kWidth; lane++) {
+      result.v_[lane] = value;
+    }
+    return result;
+  }
+  // first, first + 1, ..., first + kWidth - 1
+  static Simd Iota(T first) {
+    Simd result;
+    for (size_t lane = 0; lane < kWidth; lane++) {
+      result.v_[lane] = static_cast<T>(first + static_cast<T>(lane));
+    }
+    return result;
+  }
+
+  // p aligned to kAlignment
+  static Simd Load(const T *p) {
+    Simd result;
+#if defined(__GNUC__) || defined(__clang__)
+    std::memcpy(&result.v_, __builtin_assume_aligned(p, kAlignment), sizeof(result.v_));
+#else
+    std::memcpy(&result.v_, p, sizeof(result.v_));
+#endif
+    return result;
+  }
+  static Simd LoadUnaligned(const T *p) {
+    Simd result;
+    std::memcpy(&result.v_, p, sizeof(result.v_));
+    return result;
+  }
+  // p aligned to kAlignment
+  void Store(T *p) const {
+#if defined(__GNUC__) || defined(__clang__)
+    std::memcpy(__builtin_assume_aligned(p, kAlignment), &v_, sizeof(v_));
+#else
+    std::memcpy(p, &v_, sizeof(v_));
+#endif
+  }
+  void StoreUnaligned(T *p) const { std::memcpy(p, &v_, sizeof(v_)); }
+
+  [[nodiscard]] T operator[](size_t lane) const { return v_[lane]; }
+  // the vector itself, for intrinsics of the target
+  [[nodiscard]] const Storage &Native() const { return v_; }
+  [[nodiscard]] std::array<T, kWidth> ToArray() const {
+    std::array<T, kWidth> lanes;
+    StoreUnaligned(lanes.data());
+    return lanes;
+  }
+
+  // the lanes converted to U as by static_cast
+  template <typename U>
+  [[nodiscard]] Simd<U, kWidth * sizeof(U)> Convert() const {
+    Simd<U, kWidth * sizeof(U)> result;
+    detail::ConvertLanes(result.v_, v_);
+    return result;
+  }
+
+  friend Simd operator+(const Simd &a, const Simd &b) { return Simd(a.v_ + b.v_); }
+  friend Simd operator-(const Simd &a, const Simd &b) { return Simd(a.v_ - b.v_); }
+  friend Simd operator*(const Simd &a, const Simd &b) { return Simd(a.v_ * b.v_); }
+  friend Simd operator/(const Simd &a, const Simd &b) { return Simd(a.v_ / b.v_); }
+  Simd &operator+=(const Simd &other) { return *this = *this + other; }
+  Simd &operator-=(const Simd &other) { return *this = *this - other; }
+  Simd &operator*=(const Simd &other) { return *this = *this * other; }
+  Simd &operator/=(const Simd &other) { return *this = *this / other; }
+
+  friend Mask operator==(const Simd &a, const Simd &b) { return Mask(a.v_ == b.v_); }
+  friend Mask operator!=(const Simd &a, const Simd &b) { return Mask(a.v_ != b.v_); }
+  friend Mask operator<(const Simd &a, const Simd &b) { return Mask(a.v_ < b.v_); }
+  friend Mask operator<=(const Simd &a, const Simd &b) { return Mask(a.v_ <= b.v_); }
+  friend Mask operator>(const Simd &a, const Simd &b) { return Mask(a.v_ > b.v_); }
+  friend Mask operator>=(const Simd &a, const Simd &b) { return Mask(a.v_ >= b.v_); }
+
+  // a where mask is set, b elsewhere
+  friend Simd Select(const Mask &mask, const Simd &a, const Simd &b) {
+    Simd result;
+    detail::Blend(result.v_, mask.Native(), a.v_, b.v_);
+    return result;
+  }
+  // lane-wise std::min and std::max: a on ties
+  friend Simd Min(const Simd &a, const Simd &b) { return Select(b < a, b, a); }
+  friend Simd Max(const Simd &a, const Simd &b) { return Select(a < b, b, a); }
+  friend Simd Abs(const Simd &a) {
+    if constexpr (std::is_signed_v<T>) {
+      return Select(a < Simd(), Simd() - a, a);
+    } else {
+      return a;
+    }
+  }
+  // a * b + c rounded once for floating-point lanes (std::fma); the compiler
+  // emits FMA instructions where the target has them
+  friend Simd Fma(const Simd &a, const Simd &b, const Simd &c) {
+    if constexpr (std::is_floating_point_v<T>) {
+      Simd result;
+      for (size_t lane = 0; lane < kWidth; lane++) {
+        result.v_[lane] = std::fma(a.v_[lane], b.v_[lane], c.v_[lane]);
+      }
+      return result;
+    } else {
+      return (a * b) + c;
+    }
+  }
+
+  // Horizontal reductions folding the lanes pairwise
+  [[nodiscard]] T ReduceAdd() const {
+    return detail::FoldLanes(ToArray(), [](T a, T b) { return static_cast<T>(a + b); });
+  }
+  [[nodiscard]] T ReduceMin() const {
+    return detail::FoldLanes(ToArray(), [](T a, T b) { return std::min(a, b); });
+  }
+  [[nodiscard]] T ReduceMax() const {
+    return detail::FoldLanes(ToArray(), [](T a, T b) { return std::max(a, b); });
+  }
+
+ private:
+  template <typename U, size_t kOtherBytes>
+  friend class Simd;
+
+  Storage v_;
+};
+
+template <typename T>
+struct IndexedValue {
+  T value;
+  size_t index;
+};
+
+namespace detail {
+
+// First x[i] no other element is better than; `better` compares Simd vectors
+// and scalars. Every lane keeps its best value and the block it came from in a
+// counter of the lane size, restarted when it would overflow.
+template <size_t kBytes, typename T, typename Better>
+IndexedValue<T> ArgBest(const T *x, size_t n, Better better) {
+  using Vec = Simd<T, kBytes>;
+  using Counter = Simd<MaskLane<sizeof(T)>, kBytes>;
+  constexpr size_t kWidth = Vec::kWidth;
+  constexpr auto kMaxBlocks = static_cast<size_t>(std::numeric_limits<MaskLane<sizeof(T)>>::max());
+
+  IndexedValue<T> best{x[0], 0};
+  size_t i = 0;
+  while (n - i >= kWidth) {
+    const size_t blocks = std::min((n - i) / kWidth, kMaxBlocks);
+    const Counter one = Counter::Broadcast(1);
+    Vec best_values = Vec::LoadUnaligned(x + i);
+    Counter best_blocks;
+    Counter block;
+    for (size_t b = 1; b < blocks; b++) {
+      block += one;
+      const Vec values = Vec::LoadUnaligned(x + i + (b * kWidth));
+      const auto mask = better(values, best_values);
+      best_values = Select(mask, values, best_values);
+      best_blocks = Select(mask, block, best_blocks);
+    }
+    for (size_t lane = 0; lane < kWidth; lane++) {
+      const T value = best_values[lane];
+      const size_t index = i + (static_cast<size_t>(best_blocks[lane]) * kWidth) + lane;
+      if (better(value, best.value) || (!better(best.value, value) && index < best.index)) {
+        best = {value, index};
+      }
+    }
+    i += blocks * kWidth;
+  }
+  for (; i < n; i++) {
+    if (better(x[i], best.value)) {
+      best = {x[i], i};
+    }
+  }
+  return best;
+}
+
+}  // namespace detail
+
+// Value and index of the first smallest element of x[0, n), as std::min_element;
+// n > 0 and no NaNs
+template <typename T, size_t kBytes = kSimdBytes>
+IndexedValue<T> ArgMin(const T *x, size_t n) {
+  return detail::ArgBest<kBytes>(x, n, [](const auto &a, const auto &b) { return a < b; });
+}
+
+// Value and index of the first largest element of x[0, n), as std::max_element;
+// n > 0 and no NaNs
+template <typename T, size_t kBytes = kSimdBytes>
+IndexedValue<T> ArgMax(const T *x, size_t n) {
+  return detail::ArgBest<kBytes>(x, n, [](const auto &a, const auto &b) { return a > b; });
+}
+
+}  // namespace ppc::util
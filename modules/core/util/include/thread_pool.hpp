@@ -0,0 +1,98 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "core/util/include/affinity.hpp"
+
+namespace ppc::util {
+
+// Persistent work-stealing pool. Every thread owns a deque: it takes its own
+// jobs from the back and steals the oldest jobs of the others from the front.
+// A pool of N threads starts N - 1 workers, the thread waiting for the jobs
+// (ParallelFor, Wait) runs them as the N-th one, so nested calls from inside a
+// job do not deadlock. Several outside threads may wait at once: the first
+// one takes the slot of thread 0, the others help as threads of no slot.
+class ThreadPool {
+ public:
+  using Job = std::function<void()>;
+
+  explicit ThreadPool(int num_threads);
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+  ~ThreadPool();
+
+  // Process-wide pool of GetPPCNumThreads() threads shared by all tasks and
+  // tests, started on the first call
+  static ThreadPool &Global();
+
+  [[nodiscard]] int NumThreads() const { return static_cast<int>(queues_.size()); }
+
+  // Index of the calling thread in this pool: 1..N-1 for its workers, 0 for
+  // the outside thread holding the slot of thread 0 (inside ParallelFor, Wait
+  // or HelpUntilZero), N for any other thread
+  [[nodiscard]] int CurrentThreadIndex() const;
+
+  // Pin worker i to the i-th CPU of the placement and the calling thread,
+  // which runs as thread 0 of ParallelFor and Wait, to the first one; records
+  // the placement as "stl". No-op for AffinityKind::kNone.
+  void SetAffinity(const AffinityPolicy &policy);
+
+  // Queue an independent job; the first exception it throws is rethrown by Wait()
+  void Submit(Job job);
+  // Block until every submitted job has finished, running queued jobs meanwhile
+  void Wait();
+
+  // Low-level interface of fork-join groups: queue a job on the deque of the
+  // calling thread without tracking it, and run queued jobs until `pending`
+  // (decremented by the caller's jobs) drops to zero
+  void Spawn(Job job);
+  void HelpUntilZero(const std::atomic<size_t> &pending);
+
+  // Split [begin, end) into chunks of `grain` indices (0 - about four chunks
+  // per thread) and call body(chunk_begin, chunk_end) for each of them
+  // in parallel; returns when all chunks are done and rethrows the first
+  // exception of the body
+  void ParallelFor(size_t begin, size_t end, const std::function<void(size_t, size_t)> &body, size_t grain = 0);
+
+ private:
+  // holds the slot of thread 0 for the calling outside thread, if it is free
+  class CallerScope;
+
+  struct alignas(64) WorkerQueue {
+    std::mutex mutex;
+    std::deque<Job> jobs;
+  };
+
+  [[nodiscard]] size_t HomeQueue() const;
+  void Push(Job job, size_t queue);
+  void WakeWorkers(bool all);
+  // run one job: the back of the home queue or the front of another one
+  bool TryRunOne(size_t home);
+  void WorkerLoop(size_t index);
+
+  std::vector<std::unique_ptr<WorkerQueue>> queues_;
+  std::vector<std::thread> workers_;
+  std::atomic<size_t> queued_ = 0;
+  std::atomic<size_t> next_queue_ = 0;
+  std::atomic<bool> caller_slot_taken_ = false;
+
+  std::mutex sleep_mutex_;
+  std::condition_variable wake_;
+  bool stop_ = false;
+
+  // jobs of Submit() not finished yet and the first exception of them
+  std::atomic<size_t> unfinished_ = 0;
+  std::mutex error_mutex_;
+  std::exception_ptr error_;
+};
+
+}  // namespace ppc::util
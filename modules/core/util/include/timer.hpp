@@ -0,0 +1,84 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64)
+#define PPC_TIMER_TSC
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+
+// Low-overhead timer for per-stage and per-iteration measurements: the
+// invariant time stamp counter where the CPU has one, calibrated once per
+// process against steady_clock, and steady_clock itself elsewhere. Reading it
+// is an inline instruction instead of a clock call through std::function.
+namespace ppc::util {
+
+enum class TimerSource : uint8_t {
+  // rdtsc; the counter runs at a constant rate in every power state
+  kTsc,
+  // std::chrono::steady_clock in nanoseconds
+  kSteady,
+};
+
+struct TimerCalibration {
+  TimerSource source = TimerSource::kSteady;
+  double seconds_per_tick = 1e-9;
+  // ReadTicks() at the calibration, the zero of NowSeconds()
+  uint64_t epoch_ticks = 0;
+};
+
+// Picks and calibrates the source (about 20 ms with the TSC); PPC_TIMER
+// ("tsc" or "steady") overrides the choice, the TSC only where it is invariant.
+// Throws std::invalid_argument for other values of PPC_TIMER.
+TimerCalibration CalibrateTimer();
+
+// "tsc" or "steady"
+std::string TimerSourceName(TimerSource source);
+
+inline const TimerCalibration &GetTimerCalibration() {
+  static const TimerCalibration kCalibration = CalibrateTimer();
+  return kCalibration;
+}
+
+namespace detail {
+
+// the fences keep the read from moving across the timed instructions
+inline uint64_t ReadTsc() {
+#ifdef PPC_TIMER_TSC
+  _mm_lfence();
+  const uint64_t ticks = __rdtsc();
+  _mm_lfence();
+  return ticks;
+#else
+  return 0;
+#endif
+}
+
+inline uint64_t ReadSteadyNs() {
+  const auto since_epoch = std::chrono::steady_clock::now().time_since_epoch();
+  return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(since_epoch).count());
+}
+
+}  // namespace detail
+
+// Ticks of the calibrated source; a difference times seconds_per_tick is a duration
+inline uint64_t ReadTicks() {
+  return GetTimerCalibration().source == TimerSource::kTsc ? detail::ReadTsc() : detail::ReadSteadyNs();
+}
+
+inline double TicksToSeconds(int64_t ticks) {
+  return static_cast<double>(ticks) * GetTimerCalibration().seconds_per_tick;
+}
+
+// Seconds since the calibration; the default PerfAttr timer
+inline double NowSeconds() {
+  return TicksToSeconds(static_cast<int64_t>(ReadTicks() - GetTimerCalibration().epoch_ticks));
+}
+
+}  // namespace ppc::util
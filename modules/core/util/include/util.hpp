@@ -1,9 +1,22 @@
 #pragma once
+#include <cstddef>
 #include <string>
 
 namespace ppc::util {
 
 std::string GetAbsolutePath(const std::string &relative_path);
+// Number of threads of OpenMP, TBB and std::thread tasks: PPC_NUM_THREADS, then
+// OMP_NUM_THREADS, then GetUsableCpuCount(); throws std::invalid_argument if the
+// variable is set to anything but a positive number
 int GetPPCNumThreads();
+// CPUs the process may run on: its affinity mask limited by the cgroup v2
+// cpu.max quota (at least 1)
+int GetUsableCpuCount();
+// The cgroup v2 cpu.max quota of the process in whole CPUs, 0 if there is none
+int GetCgroupCpuLimit();
+// Size in bytes of the data (or unified) cache of the given level, 0 if unknown
+size_t GetCacheSize(int level);
+// Size in bytes of the largest cache level, 0 if unknown
+size_t GetLastLevelCacheSize();
 
 }  // namespace ppc::util
@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "core/perf/include/overhead.hpp"
+#include "core/util/include/deterministic_reduce.hpp"
+#include "core/util/include/parallel.hpp"
+#include "core/util/include/random.hpp"
+#include "core/util/include/util.hpp"
+
+namespace {
+
+constexpr size_t kElements = size_t{1} << 24;
+
+std::shared_ptr<std::vector<float>> Values() {
+  return std::make_shared<std::vector<float>>(
+      ppc::util::RandomVector<ppc::util::policy::OpenMP>(kElements, 0.0F, 1.0F, 2025));
+}
+
+}  // namespace
+
+// Cost of a thread-count-independent sum against the naive parallel one on
+// the same 2^24 floats; ns/op is the time of one whole sum
+TEST(deterministic_reduce_perf_tests, test_sum_cost) {
+  using Policy = ppc::util::policy::OpenMP;
+  const auto values = Values();
+  auto element = [&](size_t i) { return (*values)[i]; };
+  float naive_result = 0.0F;
+  std::map<int, float> deterministic_results;
+
+  auto naive = [&](int num_threads) -> std::function<void()> {
+    omp_set_num_threads(num_threads);
+    return [&] {
+      naive_result = ppc::util::ParallelReduce<Policy>(size_t{0}, kElements, 0.0F, element, std::plus<>());
+    };
+  };
+  auto deterministic = [&](int num_threads) -> std::function<void()> {
+    omp_set_num_threads(num_threads);
+    return [&, num_threads] {
+      deterministic_results[num_threads] = ppc::util::DeterministicSum<Policy, float>(kElements, element);
+    };
+  };
+
+  const int save_threads = omp_get_max_threads();
+  ppc::core::OverheadAttr attr;
+  attr.ops_per_batch = 1;
+  attr.max_threads = ppc::util::GetPPCNumThreads();
+  ppc::core::PrintOverhead("core", "naive_sum_16m", ppc::core::MeasureOverhead(naive, attr));
+  ppc::core::PrintOverhead("core", "deterministic_sum_16m", ppc::core::MeasureOverhead(deterministic, attr));
+  omp_set_num_threads(save_threads);
+
+  EXPECT_GT(naive_result, 0.0F);
+  // same bits for every thread count
+  for (const auto &[threads, sum] : deterministic_results) {
+    EXPECT_EQ(sum, deterministic_results.begin()->second) << threads << " threads";
+  }
+}
+#endif
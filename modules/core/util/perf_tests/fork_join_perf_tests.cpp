@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/perf/include/overhead.hpp"
+#include "core/util/include/fork_join.hpp"
+#include "core/util/include/parallel.hpp"
+#include "core/util/include/thread_pool.hpp"
+#include "core/util/include/util.hpp"
+
+// Recursion overhead of the fork-join API: ns/op is per spawn. The TBB variant
+// is in fork_join_tbb_perf_tests, built only with USE_TBB.
+namespace {
+
+constexpr int kSpawnDepth = 12;
+constexpr int kSpawns = (1 << kSpawnDepth) - 1;
+
+// binary recursion without work: 2^depth - 1 spawns
+template <typename Policy, typename... PoolArg>
+void SpawnTree(int depth, PoolArg &...pool) {
+  if (depth == 0) {
+    return;
+  }
+  ppc::util::TaskGroup<Policy> group(pool...);
+  group.Spawn([depth, &pool...] { SpawnTree<Policy>(depth - 1, pool...); });
+  SpawnTree<Policy>(depth - 1, pool...);
+  group.Sync();
+}
+
+void PrintPerSpawn(const std::string &operation, std::vector<ppc::core::OverheadPoint> points) {
+  for (auto &point : points) {
+    point.ns_per_op /= kSpawns;
+    point.min_ns_per_op /= kSpawns;
+    point.max_ns_per_op /= kSpawns;
+  }
+  ppc::core::PrintOverhead("core", operation, points);
+}
+
+}  // namespace
+
+// on the work-stealing pool
+TEST(fork_join_perf_tests, test_spawn_std_thread) {
+  auto factory = [](int num_threads) -> std::function<void()> {
+    auto pool = std::make_shared<ppc::util::ThreadPool>(num_threads);
+    return [pool] { SpawnTree<ppc::util::policy::StdThread>(kSpawnDepth, *pool); };
+  };
+
+  ppc::core::OverheadAttr attr;
+  attr.ops_per_batch = 10;
+  attr.max_threads = ppc::util::GetPPCNumThreads();
+  const auto points = ppc::core::MeasureOverhead(factory, attr);
+  PrintPerSpawn("fork_join_spawn_stl", points);
+
+  ASSERT_FALSE(points.empty());
+}
+
+#ifdef _OPENMP
+// on OpenMP tasks
+TEST(fork_join_perf_tests, test_spawn_omp) {
+  auto factory = [](int num_threads) -> std::function<void()> {
+    omp_set_num_threads(num_threads);
+    return [] {
+      ppc::util::ForkJoinRoot<ppc::util::policy::OpenMP>([] { SpawnTree<ppc::util::policy::OpenMP>(kSpawnDepth); });
+    };
+  };
+
+  const int save_threads = omp_get_max_threads();
+  ppc::core::OverheadAttr attr;
+  attr.ops_per_batch = 10;
+  attr.max_threads = ppc::util::GetPPCNumThreads();
+  const auto points = ppc::core::MeasureOverhead(factory, attr);
+  omp_set_num_threads(save_threads);
+  PrintPerSpawn("fork_join_spawn_omp", points);
+
+  ASSERT_FALSE(points.empty());
+}
+#endif
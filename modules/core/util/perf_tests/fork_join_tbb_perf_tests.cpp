@@ -0,0 +1,52 @@
+#include <gtest/gtest.h>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "core/perf/include/overhead.hpp"
+#include "core/util/include/fork_join.hpp"
+#include "core/util/include/fork_join_tbb.hpp"
+#include "core/util/include/parallel.hpp"
+#include "core/util/include/util.hpp"
+#include "oneapi/tbb/task_arena.h"
+
+// Recursion overhead of the fork-join API on TBB task_group, built only with
+// USE_TBB: ns/op is per spawn. Compare with fork_join_perf_tests.
+namespace {
+
+constexpr int kSpawnDepth = 12;
+constexpr int kSpawns = (1 << kSpawnDepth) - 1;
+
+// binary recursion without work: 2^depth - 1 spawns
+void SpawnTree(int depth) {
+  if (depth == 0) {
+    return;
+  }
+  ppc::util::TaskGroup<ppc::util::policy::TBB> group;
+  group.Spawn([depth] { SpawnTree(depth - 1); });
+  SpawnTree(depth - 1);
+  group.Sync();
+}
+
+}  // namespace
+
+TEST(fork_join_tbb_perf_tests, test_spawn_tbb) {
+  auto factory = [](int num_threads) -> std::function<void()> {
+    auto arena = std::make_shared<oneapi::tbb::task_arena>(num_threads);
+    return [arena] { arena->execute([] { SpawnTree(kSpawnDepth); }); };
+  };
+
+  ppc::core::OverheadAttr attr;
+  attr.ops_per_batch = 10;
+  attr.max_threads = ppc::util::GetPPCNumThreads();
+  std::vector<ppc::core::OverheadPoint> points = ppc::core::MeasureOverhead(factory, attr);
+  for (auto &point : points) {
+    point.ns_per_op /= kSpawns;
+    point.min_ns_per_op /= kSpawns;
+    point.max_ns_per_op /= kSpawns;
+  }
+  ppc::core::PrintOverhead("core", "fork_join_spawn_tbb", points);
+
+  ASSERT_FALSE(points.empty());
+}
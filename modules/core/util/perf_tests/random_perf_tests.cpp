@@ -0,0 +1,46 @@
+#include <gtest/gtest.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <vector>
+
+#include "core/perf/include/overhead.hpp"
+#include "core/util/include/parallel.hpp"
+#include "core/util/include/random.hpp"
+#include "core/util/include/util.hpp"
+
+namespace {
+
+constexpr size_t kElements = size_t{1} << 24;
+
+}  // namespace
+
+// Parallel generation of a 2^24-float input; the values do not depend on the
+// thread count
+TEST(random_perf_tests, test_random_vector_generation) {
+  using Policy = ppc::util::policy::OpenMP;
+  std::map<int, std::vector<float>> results;
+  auto generate = [&](int num_threads) -> std::function<void()> {
+    omp_set_num_threads(num_threads);
+    return [&, num_threads] {
+      results[num_threads] = ppc::util::RandomVector<Policy>(kElements, -1.0F, 1.0F, 2025);
+    };
+  };
+
+  const int save_threads = omp_get_max_threads();
+  ppc::core::OverheadAttr attr;
+  attr.ops_per_batch = 1;
+  attr.batches = 3;
+  attr.max_threads = ppc::util::GetPPCNumThreads();
+  ppc::core::PrintOverhead("core", "random_vector_16m", ppc::core::MeasureOverhead(generate, attr));
+  omp_set_num_threads(save_threads);
+
+  for (const auto &[threads, values] : results) {
+    EXPECT_EQ(values, results.begin()->second) << threads << " threads";
+  }
+}
+#endif
@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "core/perf/include/latency_histogram.hpp"
+#include "core/util/include/ring_buffer.hpp"
+#include "core/util/include/util.hpp"
+
+namespace {
+
+constexpr int kItems = 200000;
+constexpr size_t kCapacity = 1024;
+
+int64_t NowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+// baseline: a deque under one mutex with condition variables
+class MutexQueue {
+ public:
+  explicit MutexQueue(size_t capacity) : capacity_(capacity) {}
+
+  void Push(int64_t value) {
+    std::unique_lock lock(mutex_);
+    not_full_.wait(lock, [&] { return items_.size() < capacity_; });
+    items_.push_back(value);
+    not_empty_.notify_one();
+  }
+
+  int64_t Pop() {
+    std::unique_lock lock(mutex_);
+    not_empty_.wait(lock, [&] { return !items_.empty(); });
+    const int64_t value = items_.front();
+    items_.pop_front();
+    not_full_.notify_one();
+    return value;
+  }
+
+ private:
+  size_t capacity_;
+  std::mutex mutex_;
+  std::condition_variable not_full_;
+  std::condition_variable not_empty_;
+  std::deque<int64_t> items_;
+};
+
+// Producers push their enqueue timestamps, consumers record the time each one
+// spent in the queue; prints throughput and latency percentiles
+template <typename Queue>
+void RunQueue(const std::string &label, int producers, int consumers) {
+  Queue queue(kCapacity);
+  const int per_producer = kItems / producers;
+  const int total = per_producer * producers;
+  std::vector<ppc::core::LatencyHistogram> latencies(consumers);
+  std::vector<std::thread> threads;
+
+  const int64_t start = NowNs();
+  for (int p = 0; p < producers; p++) {
+    threads.emplace_back([&queue, per_producer] {
+      for (int i = 0; i < per_producer; i++) {
+        queue.Push(NowNs());
+      }
+    });
+  }
+  for (int c = 0; c < consumers; c++) {
+    const int share = c + 1 < consumers ? total / consumers : total - ((total / consumers) * (consumers - 1));
+    threads.emplace_back([&queue, &latencies, c, share] {
+      for (int i = 0; i < share; i++) {
+        const int64_t pushed = queue.Pop();
+        latencies[c].Record(NowNs() - pushed);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  const int64_t elapsed = std::max<int64_t>(NowNs() - start, 1);
+
+  ppc::core::LatencyHistogram latency;
+  for (const auto &histogram : latencies) {
+    latency.Merge(histogram);
+  }
+  std::cout << "core:ring_buffer:" << label << " p=" << producers << " c=" << consumers
+            << " items/s=" << static_cast<int64_t>(static_cast<double>(total) * 1e9 / static_cast<double>(elapsed))
+            << " p50=" << latency.Percentile(0.5) << "ns p99=" << latency.Percentile(0.99) << "ns" << '\n';
+
+  ASSERT_EQ(latency.Count(), static_cast<uint64_t>(total));
+}
+
+// producer/consumer counts 1:1, then up to the number of threads each
+std::vector<std::pair<int, int>> QueueShapes() {
+  const int max_threads = std::max(2, ppc::util::GetPPCNumThreads());
+  std::vector<std::pair<int, int>> shapes;
+  for (int threads = 1; 2 * threads <= max_threads || threads == 1; threads *= 2) {
+    shapes.emplace_back(threads, threads);
+  }
+  for (const auto &shape : {std::pair{max_threads - 1, 1}, std::pair{1, max_threads - 1}}) {
+    if (std::ranges::find(shapes, shape) == shapes.end()) {
+      shapes.push_back(shape);
+    }
+  }
+  return shapes;
+}
+
+}  // namespace
+
+TEST(ring_buffer_perf_tests, test_spsc) {
+  RunQueue<ppc::util::SpscRingBuffer<int64_t, ppc::util::SpinWait>>("spsc_spin", 1, 1);
+  RunQueue<ppc::util::SpscRingBuffer<int64_t, ppc::util::BlockingWait>>("spsc_blocking", 1, 1);
+  RunQueue<MutexQueue>("mutex", 1, 1);
+}
+
+TEST(ring_buffer_perf_tests, test_mpmc) {
+  for (const auto &[producers, consumers] : QueueShapes()) {
+    RunQueue<ppc::util::MpmcRingBuffer<int64_t, ppc::util::SpinWait>>("mpmc_spin", producers, consumers);
+    RunQueue<ppc::util::MpmcRingBuffer<int64_t, ppc::util::BlockingWait>>("mpmc_blocking", producers, consumers);
+    RunQueue<MutexQueue>("mutex", producers, consumers);
+  }
+}
@@ -0,0 +1,286 @@
+#include "core/util/include/affinity.hpp"
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// Non-negative decimal number, -1 if `text` is anything else
+int ParseCpu(const std::string &text) {
+  if (text.empty() || text.size() > 6 || !std::ranges::all_of(text, [](char c) { return c >= '0' && c <= '9'; })) {
+    return -1;
+  }
+  return std::stoi(text);
+}
+
+// "0,2,4-7" -> {0, 2, 4, 5, 6, 7}
+std::vector<int> ParseCpuList(const std::string &text) {
+  std::vector<int> cpus;
+  std::stringstream list(text);
+  std::string item;
+  while (std::getline(list, item, ',')) {
+    const auto dash = item.find('-');
+    const int first = ParseCpu(item.substr(0, dash));
+    const int last = dash == std::string::npos ? first : ParseCpu(item.substr(dash + 1));
+    if (first < 0 || last < first) {
+      throw std::invalid_argument("'" + text + "' is not an affinity policy or a CPU list");
+    }
+    for (int cpu = first; cpu <= last; cpu++) {
+      cpus.push_back(cpu);
+    }
+  }
+  if (cpus.empty()) {
+    throw std::invalid_argument("'" + text + "' is not an affinity policy or a CPU list");
+  }
+  return cpus;
+}
+
+int ReadTopologyId(int cpu, const std::string &name, int fallback) {
+  std::ifstream file("/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/topology/" + name);
+  int id = -1;
+  return (file >> id) && id >= 0 ? id : fallback;
+}
+
+// Rank of every CPU among the SMT siblings of its core and rank of the core
+// among the cores of its package
+void RankCores(const std::vector<ppc::util::CpuLocation> &cpus, std::vector<int> &sibling_rank,
+               std::vector<int> &core_rank) {
+  std::map<std::pair<int, int>, int> siblings_seen;
+  std::map<int, std::set<int>> package_cores;
+  for (const auto &location : cpus) {
+    package_cores[location.package].insert(location.core);
+  }
+  sibling_rank.clear();
+  core_rank.clear();
+  for (const auto &location : cpus) {
+    sibling_rank.push_back(siblings_seen[{location.package, location.core}]++);
+    const auto &cores = package_cores[location.package];
+    core_rank.push_back(static_cast<int>(std::distance(cores.begin(), cores.find(location.core))));
+  }
+}
+
+std::mutex placement_mutex;
+std::map<std::string, std::string> placements;
+
+}  // namespace
+
+ppc::util::AffinityPolicy ppc::util::AffinityPolicy::Parse(const std::string &text) {
+  AffinityPolicy policy;
+  if (text == "none") {
+    policy.kind = AffinityKind::kNone;
+  } else if (text == "compact") {
+    policy.kind = AffinityKind::kCompact;
+  } else if (text == "scatter") {
+    policy.kind = AffinityKind::kScatter;
+  } else {
+    policy.kind = AffinityKind::kExplicit;
+    policy.cpus = ParseCpuList(text);
+  }
+  return policy;
+}
+
+std::string ppc::util::AffinityPolicy::Name() const {
+  switch (kind) {
+    case AffinityKind::kCompact:
+      return "compact";
+    case AffinityKind::kScatter:
+      return "scatter";
+    case AffinityKind::kExplicit:
+      return "explicit";
+    case AffinityKind::kNone:
+      break;
+  }
+  return "none";
+}
+
+ppc::util::AffinityPolicy ppc::util::GetAffinityPolicy() {
+  std::string value;
+#ifdef _WIN32
+  size_t len;
+  char env_buf[1024];
+  if (getenv_s(&len, env_buf, sizeof(env_buf), "PPC_AFFINITY") == 0 && len != 0) {
+    value = env_buf;
+  }
+#else
+  if (const char *env_ptr = std::getenv("PPC_AFFINITY")) {
+    value = env_ptr;
+  }
+#endif
+  return value.empty() ? AffinityPolicy{} : AffinityPolicy::Parse(value);
+}
+
+std::vector<ppc::util::CpuLocation> ppc::util::GetCpuTopology() {
+  std::vector<int> cpus;
+#ifdef __linux__
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+      if (CPU_ISSET(cpu, &set)) {
+        cpus.push_back(cpu);
+      }
+    }
+  }
+#endif
+  if (cpus.empty()) {
+    const int count = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    for (int cpu = 0; cpu < count; cpu++) {
+      cpus.push_back(cpu);
+    }
+  }
+  return GetCpuTopology(cpus);
+}
+
+std::vector<ppc::util::CpuLocation> ppc::util::GetCpuTopology(const std::vector<int> &cpus) {
+  std::vector<CpuLocation> locations;
+  locations.reserve(cpus.size());
+  for (const int cpu : cpus) {
+    locations.push_back({cpu, ReadTopologyId(cpu, "physical_package_id", 0), ReadTopologyId(cpu, "core_id", cpu)});
+  }
+  return locations;
+}
+
+std::vector<int> ppc::util::PlanPlacement(const AffinityPolicy &policy, int num_threads,
+                                          const std::vector<CpuLocation> &cpus) {
+  if (policy.kind == AffinityKind::kNone || num_threads <= 0) {
+    return {};
+  }
+  std::vector<int> order;
+  if (policy.kind == AffinityKind::kExplicit) {
+    order = policy.cpus;
+  } else {
+    if (cpus.empty()) {
+      return {};
+    }
+    std::vector<int> sibling_rank;
+    std::vector<int> core_rank;
+    RankCores(cpus, sibling_rank, core_rank);
+    std::vector<size_t> indices(cpus.size());
+    for (size_t i = 0; i < indices.size(); i++) {
+      indices[i] = i;
+    }
+    auto key = [&](size_t i) {
+      const auto &location = cpus[i];
+      return policy.kind == AffinityKind::kCompact
+                 ? std::make_tuple(location.package, core_rank[i], sibling_rank[i], location.cpu)
+                 : std::make_tuple(sibling_rank[i], core_rank[i], location.package, location.cpu);
+    };
+    std::ranges::sort(indices, [&](size_t a, size_t b) { return key(a) < key(b); });
+    for (const size_t i : indices) {
+      order.push_back(cpus[i].cpu);
+    }
+  }
+  std::vector<int> placement(num_threads);
+  for (size_t thread = 0; thread < placement.size(); thread++) {
+    placement[thread] = order[thread % order.size()];
+  }
+  return placement;
+}
+
+bool ppc::util::PinCurrentThread(int cpu) {
+#ifdef __linux__
+  if (cpu < 0 || cpu >= CPU_SETSIZE) {
+    return false;
+  }
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+  (void)cpu;
+  return false;
+#endif
+}
+
+bool ppc::util::PinThread(std::thread &thread, int cpu) {
+#ifdef __linux__
+  if (cpu < 0 || cpu >= CPU_SETSIZE) {
+    return false;
+  }
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  return pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set) == 0;
+#else
+  (void)thread;
+  (void)cpu;
+  return false;
+#endif
+}
+
+bool ppc::util::RestrictCurrentThread(const std::vector<int> &cpus) {
+#ifdef __linux__
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (const int cpu : cpus) {
+    if (cpu < 0 || cpu >= CPU_SETSIZE) {
+      return false;
+    }
+    CPU_SET(cpu, &set);
+  }
+  return !cpus.empty() && sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+  (void)cpus;
+  return false;
+#endif
+}
+
+std::vector<int> ppc::util::PartitionCpus(const std::vector<CpuLocation> &node_cpus, int local_rank, int local_size) {
+  if (local_size <= 0 || local_rank < 0 || local_rank >= local_size) {
+    throw std::invalid_argument("process " + std::to_string(local_rank) + " of " + std::to_string(local_size));
+  }
+  AffinityPolicy compact;
+  compact.kind = AffinityKind::kCompact;
+  const auto order = PlanPlacement(compact, static_cast<int>(node_cpus.size()), node_cpus);
+  if (order.empty()) {
+    return {};
+  }
+  const auto count = static_cast<int>(order.size());
+  if (local_size >= count) {
+    return {order[local_rank % count]};
+  }
+  // the first `count % local_size` processes get one CPU more
+  const int base = count / local_size;
+  const int extra = count % local_size;
+  const int begin = (local_rank * base) + std::min(local_rank, extra);
+  const int size = base + (local_rank < extra ? 1 : 0);
+  return {order.begin() + begin, order.begin() + begin + size};
+}
+
+void ppc::util::RecordPlacement(const std::string &backend, const AffinityPolicy &policy,
+                                const std::vector<int> &cpus) {
+  std::stringstream line;
+  line << policy.Name() << "[";
+  for (size_t i = 0; i < cpus.size(); i++) {
+    line << (i == 0 ? "" : ",") << cpus[i];
+  }
+  line << "]";
+  std::lock_guard lock(placement_mutex);
+  placements[backend] = line.str();
+}
+
+std::string ppc::util::PlacementSummary() {
+  std::lock_guard lock(placement_mutex);
+  std::string summary;
+  for (const auto &[backend, placement] : placements) {
+    summary += (summary.empty() ? "" : " ") + backend + ":" + placement;
+  }
+  return summary;
+}
@@ -0,0 +1,69 @@
+#include "core/util/include/cpu_dispatch.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+constexpr std::array<const char *, ppc::util::kIsaLevels> kIsaNames = {"scalar", "sse4.2", "avx2", "avx512"};
+
+ppc::util::IsaLevel LevelFromEnvironment() {
+  std::string value;
+#ifdef _WIN32
+  size_t len;
+  char env_buf[64];
+  if (getenv_s(&len, env_buf, sizeof(env_buf), "PPC_ISA") == 0 && len != 0) {
+    value = env_buf;
+  }
+#else
+  if (const char *env_ptr = std::getenv("PPC_ISA")) {
+    value = env_ptr;
+  }
+#endif
+  const auto detected = ppc::util::DetectIsaLevel();
+  return value.empty() ? detected : std::min(detected, ppc::util::ParseIsaLevel(value));
+}
+
+std::atomic<ppc::util::IsaLevel> &CurrentLevel() {
+  static std::atomic<ppc::util::IsaLevel> level = LevelFromEnvironment();
+  return level;
+}
+
+}  // namespace
+
+ppc::util::IsaLevel ppc::util::DetectIsaLevel() {
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+  // __builtin_cpu_supports also checks that the OS saves the wide registers
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vl") &&
+      __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512dq")) {
+    return IsaLevel::kAvx512;
+  }
+  if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+    return IsaLevel::kAvx2;
+  }
+  if (__builtin_cpu_supports("sse4.2")) {
+    return IsaLevel::kSse42;
+  }
+#endif
+  return IsaLevel::kScalar;
+}
+
+ppc::util::IsaLevel ppc::util::GetIsaLevel() { return CurrentLevel().load(std::memory_order_relaxed); }
+
+ppc::util::IsaLevel ppc::util::SetIsaLevel(IsaLevel level) {
+  return CurrentLevel().exchange(std::min(level, DetectIsaLevel()), std::memory_order_relaxed);
+}
+
+std::string ppc::util::IsaName(IsaLevel level) { return kIsaNames.at(static_cast<size_t>(level)); }
+
+ppc::util::IsaLevel ppc::util::ParseIsaLevel(const std::string &name) {
+  const auto *found = std::ranges::find(kIsaNames, name);
+  if (found == kIsaNames.end()) {
+    throw std::invalid_argument("'" + name + "' is not one of scalar, sse4.2, avx2, avx512");
+  }
+  return static_cast<IsaLevel>(found - kIsaNames.begin());
+}
@@ -0,0 +1,280 @@
+#include "core/util/include/kernels.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "core/util/include/cpu_dispatch.hpp"
+#include "core/util/include/simd.hpp"
+
+// The scalar variants are plain loops over the lanes. The others use Simd
+// vectors of the register width of the instruction set and are compiled three
+// times with target attributes; always_inline puts the shared body into each
+// of them.
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define PPC_KERNEL_VARIANTS
+#define PPC_KERNEL_INLINE [[gnu::always_inline]] inline
+#include <immintrin.h>
+#endif
+
+namespace {
+
+using ppc::util::kKernelLanes;
+
+template <typename T>
+using Lanes = std::array<T, kKernelLanes>;
+
+// lane 0 += lane 16, ..., then lane 0 += lane 8, ... down to lane 0
+template <typename T>
+T FoldLanes(Lanes<T> &lanes) {
+  for (size_t width = kKernelLanes / 2; width > 0; width /= 2) {
+    for (size_t lane = 0; lane < width; lane++) {
+      lanes[lane] += lanes[lane + width];
+    }
+  }
+  return lanes[0];
+}
+
+template <typename T>
+T SumScalar(const T *x, size_t n) {
+  Lanes<T> lanes{};
+  for (size_t i = 0; i < n; i++) {
+    lanes[i % kKernelLanes] += x[i];
+  }
+  return FoldLanes(lanes);
+}
+
+template <typename T>
+double DotScalar(const T *x, const T *y, size_t n) {
+  Lanes<double> lanes{};
+  for (size_t i = 0; i < n; i++) {
+    lanes[i % kKernelLanes] += static_cast<double>(x[i]) * static_cast<double>(y[i]);
+  }
+  return FoldLanes(lanes);
+}
+
+template <typename T>
+void GemmScalar(const T *a, const T *b, T *c, size_t n, size_t row_begin, size_t row_end) {
+  for (size_t i = row_begin; i < row_end; i++) {
+    T *c_row = c + (i * n);
+    std::fill(c_row, c_row + n, T{0});
+    for (size_t k = 0; k < n; k++) {
+      const T a_ik = a[(i * n) + k];
+      const T *b_row = b + (k * n);
+      for (size_t j = 0; j < n; j++) {
+        c_row[j] += a_ik * b_row[j];
+      }
+    }
+  }
+}
+
+// multiplier and addend of the peak probe: the chains neither overflow nor
+// turn subnormal
+constexpr double kPeakMul = 0.999999;
+constexpr double kPeakAdd = 1e-6;
+// independent vector chains of the peak probe, enough to cover the latency of
+// two FMA pipes and to fit the 16 vector registers of AVX2
+constexpr size_t kPeakVectors = 12;
+
+double FmaPeakScalar(int64_t iterations, double &sink) {
+  Lanes<double> acc;
+  acc.fill(1.0);
+  for (int64_t it = 0; it < iterations; it++) {
+    for (double &value : acc) {
+      value = (value * kPeakMul) + kPeakAdd;
+    }
+  }
+  sink = FoldLanes(acc);
+  return 2.0 * kKernelLanes * static_cast<double>(iterations);
+}
+
+#ifdef PPC_KERNEL_VARIANTS
+
+// kKernelLanes lanes as vectors of kBytes, spilled to scalar lanes for the tail
+template <size_t kBytes, typename T>
+PPC_KERNEL_INLINE T SumWide(const T *x, size_t n) {
+  using Vec = ppc::util::Simd<T, kBytes>;
+  std::array<Vec, kKernelLanes / Vec::kWidth> acc;
+  size_t i = 0;
+  for (; i + kKernelLanes <= n; i += kKernelLanes) {
+    for (size_t v = 0; v < acc.size(); v++) {
+      acc[v] += Vec::LoadUnaligned(x + i + (v * Vec::kWidth));
+    }
+  }
+  Lanes<T> lanes;
+  for (size_t v = 0; v < acc.size(); v++) {
+    acc[v].StoreUnaligned(lanes.data() + (v * Vec::kWidth));
+  }
+  for (; i < n; i++) {
+    lanes[i % kKernelLanes] += x[i];
+  }
+  return FoldLanes(lanes);
+}
+
+template <size_t kBytes, typename T>
+PPC_KERNEL_INLINE double DotWide(const T *x, const T *y, size_t n) {
+  using Acc = ppc::util::Simd<double, kBytes>;
+  using Vec = ppc::util::Simd<T, Acc::kWidth * sizeof(T)>;
+  std::array<Acc, kKernelLanes / Acc::kWidth> acc;
+  size_t i = 0;
+  for (; i + kKernelLanes <= n; i += kKernelLanes) {
+    for (size_t v = 0; v < acc.size(); v++) {
+      const size_t offset = i + (v * Acc::kWidth);
+      acc[v] += Vec::LoadUnaligned(x + offset).template Convert<double>() *
+                Vec::LoadUnaligned(y + offset).template Convert<double>();
+    }
+  }
+  Lanes<double> lanes;
+  for (size_t v = 0; v < acc.size(); v++) {
+    acc[v].StoreUnaligned(lanes.data() + (v * Acc::kWidth));
+  }
+  for (; i < n; i++) {
+    lanes[i % kKernelLanes] += static_cast<double>(x[i]) * static_cast<double>(y[i]);
+  }
+  return FoldLanes(lanes);
+}
+
+// i-k-j order: the inner loop streams a row of b into a row of c
+template <size_t kBytes, typename T>
+PPC_KERNEL_INLINE void GemmWide(const T *a, const T *b, T *c, size_t n, size_t row_begin, size_t row_end) {
+  using Vec = ppc::util::Simd<T, kBytes>;
+  for (size_t i = row_begin; i < row_end; i++) {
+    T *c_row = c + (i * n);
+    std::fill(c_row, c_row + n, T{0});
+    for (size_t k = 0; k < n; k++) {
+      const T a_ik = a[(i * n) + k];
+      const Vec a_part = Vec::Broadcast(a_ik);
+      const T *b_row = b + (k * n);
+      size_t j = 0;
+      for (; j + Vec::kWidth <= n; j += Vec::kWidth) {
+        (Vec::LoadUnaligned(c_row + j) + (a_part * Vec::LoadUnaligned(b_row + j))).StoreUnaligned(c_row + j);
+      }
+      for (; j < n; j++) {
+        c_row[j] += a_ik * b_row[j];
+      }
+    }
+  }
+}
+
+template <size_t kBytes>
+using Doubles = ppc::util::Simd<double, kBytes>;
+
+// acc = acc * mul + add: one vfmadd on AVX2 and AVX-512 at any optimization
+// level (Fma() vectorizes only where the compiler vectorizes std::fma), a
+// multiply and an add on SSE4.2, which has no FMA. The intrinsic overloads
+// are not always_inline: they inline only into a caller of their target.
+template <size_t kBytes>
+PPC_KERNEL_INLINE void MultiplyAdd(Doubles<kBytes> &acc, const Doubles<kBytes> &mul, const Doubles<kBytes> &add) {
+  acc = (acc * mul) + add;
+}
+
+__attribute__((target("avx2,fma"))) inline void MultiplyAdd(Doubles<32> &acc, const Doubles<32> &mul,
+                                                            const Doubles<32> &add) {
+  acc = Doubles<32>(_mm256_fmadd_pd(acc.Native(), mul.Native(), add.Native()));
+}
+
+__attribute__((target("avx512f"))) inline void MultiplyAdd(Doubles<64> &acc, const Doubles<64> &mul,
+                                                           const Doubles<64> &add) {
+  acc = Doubles<64>(_mm512_fmadd_pd(acc.Native(), mul.Native(), add.Native()));
+}
+
+template <size_t kBytes>
+PPC_KERNEL_INLINE double FmaPeakWide(int64_t iterations, double &sink) {
+  using Vec = Doubles<kBytes>;
+  const Vec mul = Vec::Broadcast(kPeakMul);
+  const Vec add = Vec::Broadcast(kPeakAdd);
+  std::array<Vec, kPeakVectors> acc;
+  acc.fill(Vec::Broadcast(1.0));
+  for (int64_t it = 0; it < iterations; it++) {
+    // unrolled, so that the chains stay in registers
+#pragma GCC unroll 16
+    for (Vec &value : acc) {
+      MultiplyAdd(value, mul, add);
+    }
+  }
+  Vec total;
+  for (const Vec &value : acc) {
+    total += value;
+  }
+  sink = total.ReduceAdd();
+  return 2.0 * kPeakVectors * Vec::kWidth * static_cast<double>(iterations);
+}
+
+// name##Sse42, name##Avx2 and name##Avx512 running `impl args` on vectors of
+// the register width of the target; flatten also inlines the Simd operations,
+// which must not run as out-of-line baseline copies
+#define PPC_ISA_VARIANTS(name, ret, params, impl, args)                                           \
+  __attribute__((target("sse4.2"), flatten)) ret name##Sse42 params { return impl<16> args; }     \
+  __attribute__((target("avx2,fma"), flatten)) ret name##Avx2 params { return impl<32> args; }    \
+  __attribute__((target("avx512f,avx512vl,avx512bw,avx512dq"), flatten)) ret name##Avx512 params { \
+    return impl<64> args;                                                                         \
+  }
+#define PPC_DISPATCH_VARIANTS(name, scalar) {scalar, name##Sse42, name##Avx2, name##Avx512}
+
+PPC_ISA_VARIANTS(SumFloat, float, (const float *x, size_t n), SumWide, (x, n))
+PPC_ISA_VARIANTS(SumDouble, double, (const double *x, size_t n), SumWide, (x, n))
+PPC_ISA_VARIANTS(DotFloat, double, (const float *x, const float *y, size_t n), DotWide, (x, y, n))
+PPC_ISA_VARIANTS(DotDouble, double, (const double *x, const double *y, size_t n), DotWide, (x, y, n))
+PPC_ISA_VARIANTS(GemmInt, void, (const int *a, const int *b, int *c, size_t n, size_t begin, size_t end), GemmWide,
+                 (a, b, c, n, begin, end))
+PPC_ISA_VARIANTS(GemmFloat, void, (const float *a, const float *b, float *c, size_t n, size_t begin, size_t end),
+                 GemmWide, (a, b, c, n, begin, end))
+PPC_ISA_VARIANTS(GemmDouble, void,
+                 (const double *a, const double *b, double *c, size_t n, size_t begin, size_t end), GemmWide,
+                 (a, b, c, n, begin, end))
+PPC_ISA_VARIANTS(FmaPeak, double, (int64_t iterations, double &sink), FmaPeakWide, (iterations, sink))
+
+#else
+
+#define PPC_DISPATCH_VARIANTS(name, scalar) {scalar, nullptr, nullptr, nullptr}
+
+#endif
+
+}  // namespace
+
+float ppc::util::SumBlock(const float *x, size_t n) {
+  static const DispatchTable<float(const float *, size_t)> kTable(PPC_DISPATCH_VARIANTS(SumFloat, SumScalar<float>));
+  return kTable.Select()(x, n);
+}
+
+double ppc::util::SumBlock(const double *x, size_t n) {
+  static const DispatchTable<double(const double *, size_t)> kTable(
+      PPC_DISPATCH_VARIANTS(SumDouble, SumScalar<double>));
+  return kTable.Select()(x, n);
+}
+
+double ppc::util::DotBlock(const float *x, const float *y, size_t n) {
+  static const DispatchTable<double(const float *, const float *, size_t)> kTable(
+      PPC_DISPATCH_VARIANTS(DotFloat, DotScalar<float>));
+  return kTable.Select()(x, y, n);
+}
+
+double ppc::util::DotBlock(const double *x, const double *y, size_t n) {
+  static const DispatchTable<double(const double *, const double *, size_t)> kTable(
+      PPC_DISPATCH_VARIANTS(DotDouble, DotScalar<double>));
+  return kTable.Select()(x, y, n);
+}
+
+void ppc::util::GemmRows(const int *a, const int *b, int *c, size_t n, size_t row_begin, size_t row_end) {
+  static const DispatchTable<void(const int *, const int *, int *, size_t, size_t, size_t)> kTable(
+      PPC_DISPATCH_VARIANTS(GemmInt, GemmScalar<int>));
+  kTable.Select()(a, b, c, n, row_begin, row_end);
+}
+
+void ppc::util::GemmRows(const float *a, const float *b, float *c, size_t n, size_t row_begin, size_t row_end) {
+  static const DispatchTable<void(const float *, const float *, float *, size_t, size_t, size_t)> kTable(
+      PPC_DISPATCH_VARIANTS(GemmFloat, GemmScalar<float>));
+  kTable.Select()(a, b, c, n, row_begin, row_end);
+}
+
+void ppc::util::GemmRows(const double *a, const double *b, double *c, size_t n, size_t row_begin, size_t row_end) {
+  static const DispatchTable<void(const double *, const double *, double *, size_t, size_t, size_t)> kTable(
+      PPC_DISPATCH_VARIANTS(GemmDouble, GemmScalar<double>));
+  kTable.Select()(a, b, c, n, row_begin, row_end);
+}
+
+double ppc::util::FmaPeak(int64_t iterations, double &sink) {
+  static const DispatchTable<double(int64_t, double &)> kTable(PPC_DISPATCH_VARIANTS(FmaPeak, FmaPeakScalar));
+  return kTable.Select()(iterations, sink);
+}
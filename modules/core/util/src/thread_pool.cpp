@@ -0,0 +1,266 @@
+#include "core/util/include/thread_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "core/util/include/affinity.hpp"
+#include "core/util/include/util.hpp"
+
+namespace {
+
+// pool and queue of the worker running on this thread, or of the outside
+// thread holding the slot of thread 0
+thread_local const ppc::util::ThreadPool *tls_pool = nullptr;
+thread_local size_t tls_queue = 0;
+
+}  // namespace
+
+class ppc::util::ThreadPool::CallerScope {
+ public:
+  explicit CallerScope(ThreadPool &pool) : pool_(pool) {
+    // workers and the holder itself already have their slot
+    if (tls_pool == &pool_ || pool_.caller_slot_taken_.exchange(true, std::memory_order_acquire)) {
+      return;
+    }
+    held_ = true;
+    saved_pool_ = tls_pool;
+    saved_queue_ = tls_queue;
+    tls_pool = &pool_;
+    tls_queue = 0;
+  }
+  CallerScope(const CallerScope &) = delete;
+  CallerScope &operator=(const CallerScope &) = delete;
+  ~CallerScope() {
+    if (held_) {
+      tls_pool = saved_pool_;
+      tls_queue = saved_queue_;
+      pool_.caller_slot_taken_.store(false, std::memory_order_release);
+    }
+  }
+
+ private:
+  ThreadPool &pool_;
+  bool held_ = false;
+  const ThreadPool *saved_pool_ = nullptr;
+  size_t saved_queue_ = 0;
+};
+
+ppc::util::ThreadPool::ThreadPool(int num_threads) {
+  if (num_threads <= 0) {
+    throw std::invalid_argument("ThreadPool needs a positive number of threads");
+  }
+  for (int i = 0; i < num_threads; i++) {
+    queues_.push_back(std::make_unique<WorkerQueue>());
+  }
+  for (size_t index = 1; index < queues_.size(); index++) {
+    workers_.emplace_back([this, index] { WorkerLoop(index); });
+  }
+}
+
+ppc::util::ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard lock(sleep_mutex_);
+    stop_ = true;
+  }
+  wake_.notify_all();
+  for (auto &worker : workers_) {
+    worker.join();
+  }
+  // a pool without workers runs the jobs nobody waited for here
+  while (TryRunOne(0)) {
+  }
+}
+
+ppc::util::ThreadPool &ppc::util::ThreadPool::Global() {
+  static ThreadPool pool(GetPPCNumThreads());
+  return pool;
+}
+
+int ppc::util::ThreadPool::CurrentThreadIndex() const {
+  return tls_pool == this ? static_cast<int>(tls_queue) : NumThreads();
+}
+
+void ppc::util::ThreadPool::SetAffinity(const AffinityPolicy &policy) {
+  const auto placement = PlanPlacement(policy, NumThreads(), GetCpuTopology());
+  if (placement.empty()) {
+    return;
+  }
+  std::vector<int> pinned(placement.size(), -1);
+  pinned[0] = PinCurrentThread(placement[0]) ? placement[0] : -1;
+  for (size_t index = 1; index < placement.size(); index++) {
+    pinned[index] = PinThread(workers_[index - 1], placement[index]) ? placement[index] : -1;
+  }
+  RecordPlacement("stl", policy, pinned);
+}
+
+size_t ppc::util::ThreadPool::HomeQueue() const { return tls_pool == this ? tls_queue : 0; }
+
+void ppc::util::ThreadPool::Submit(Job job) {
+  unfinished_.fetch_add(1, std::memory_order_relaxed);
+  auto wrapped = [this, job = std::move(job)] {
+    try {
+      job();
+    } catch (...) {
+      std::lock_guard lock(error_mutex_);
+      if (!error_) {
+        error_ = std::current_exception();
+      }
+    }
+    unfinished_.fetch_sub(1, std::memory_order_release);
+  };
+  // workers keep their own jobs local, other threads spread them over the queues
+  const size_t queue = tls_pool == this ? tls_queue : next_queue_.fetch_add(1, std::memory_order_relaxed);
+  Push(std::move(wrapped), queue % queues_.size());
+  WakeWorkers(false);
+}
+
+void ppc::util::ThreadPool::Wait() {
+  HelpUntilZero(unfinished_);
+  std::exception_ptr error;
+  {
+    std::lock_guard lock(error_mutex_);
+    std::swap(error, error_);
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+void ppc::util::ThreadPool::Spawn(Job job) {
+  Push(std::move(job), HomeQueue());
+  WakeWorkers(false);
+}
+
+void ppc::util::ThreadPool::HelpUntilZero(const std::atomic<size_t> &pending) {
+  const CallerScope caller(*this);
+  const size_t home = HomeQueue();
+  while (pending.load(std::memory_order_acquire) > 0) {
+    if (!TryRunOne(home)) {
+      std::this_thread::yield();
+    }
+  }
+}
+
+void ppc::util::ThreadPool::ParallelFor(size_t begin, size_t end, const std::function<void(size_t, size_t)> &body,
+                                        size_t grain) {
+  if (begin >= end) {
+    return;
+  }
+  const CallerScope caller(*this);
+  const size_t count = end - begin;
+  const size_t threads = queues_.size();
+  if (grain == 0) {
+    grain = std::max<size_t>(1, count / (4 * threads));
+  }
+  const size_t chunks = (count + grain - 1) / grain;
+  if (chunks == 1 || threads == 1) {
+    body(begin, end);
+    return;
+  }
+
+  std::atomic<size_t> remaining = chunks - 1;
+  std::mutex error_mutex;
+  std::exception_ptr error;
+  auto run_chunk = [&](size_t chunk) {
+    try {
+      body(begin + (chunk * grain), std::min(end, begin + ((chunk + 1) * grain)));
+    } catch (...) {
+      std::lock_guard lock(error_mutex);
+      if (!error) {
+        error = std::current_exception();
+      }
+    }
+  };
+
+  // chunk `c` goes to the queue `c` places after the caller's one, so every
+  // worker starts with local work; the caller runs chunk 0 itself
+  const size_t home = HomeQueue();
+  for (size_t chunk = 1; chunk < chunks; chunk++) {
+    Push(
+        [&, chunk] {
+          run_chunk(chunk);
+          remaining.fetch_sub(1, std::memory_order_release);
+        },
+        (home + chunk) % threads);
+  }
+  WakeWorkers(true);
+  run_chunk(0);
+  HelpUntilZero(remaining);
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+void ppc::util::ThreadPool::Push(Job job, size_t queue) {
+  // counted first, so that queued_ never drops below the number of queued jobs
+  queued_.fetch_add(1, std::memory_order_release);
+  std::lock_guard lock(queues_[queue]->mutex);
+  queues_[queue]->jobs.push_back(std::move(job));
+}
+
+void ppc::util::ThreadPool::WakeWorkers(bool all) {
+  if (workers_.empty()) {
+    return;
+  }
+  // a worker checks queued_ under sleep_mutex_ before it sleeps: taking the
+  // mutex here orders the push before that check or the notification after it
+  {
+    std::lock_guard lock(sleep_mutex_);
+  }
+  if (all) {
+    wake_.notify_all();
+  } else {
+    wake_.notify_one();
+  }
+}
+
+bool ppc::util::ThreadPool::TryRunOne(size_t home) {
+  if (queued_.load(std::memory_order_acquire) == 0) {
+    return false;
+  }
+  Job job;
+  for (size_t i = 0; i < queues_.size() && !job; i++) {
+    auto &queue = *queues_[(home + i) % queues_.size()];
+    std::lock_guard lock(queue.mutex);
+    if (queue.jobs.empty()) {
+      continue;
+    }
+    // newest own job (still warm in cache), oldest job of the others
+    if (i == 0) {
+      job = std::move(queue.jobs.back());
+      queue.jobs.pop_back();
+    } else {
+      job = std::move(queue.jobs.front());
+      queue.jobs.pop_front();
+    }
+  }
+  if (!job) {
+    return false;
+  }
+  queued_.fetch_sub(1, std::memory_order_relaxed);
+  job();
+  return true;
+}
+
+void ppc::util::ThreadPool::WorkerLoop(size_t index) {
+  tls_pool = this;
+  tls_queue = index;
+  while (true) {
+    if (TryRunOne(index)) {
+      continue;
+    }
+    std::unique_lock lock(sleep_mutex_);
+    wake_.wait(lock, [this] { return stop_ || queued_.load(std::memory_order_acquire) > 0; });
+    if (stop_ && queued_.load(std::memory_order_acquire) == 0) {
+      return;
+    }
+  }
+}
@@ -0,0 +1,104 @@
+#include "core/util/include/timer.hpp"
+
+#ifdef PPC_TIMER_TSC
+#ifndef _MSC_VER
+#include <cpuid.h>
+#endif
+#endif
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+// time the TSC is compared with steady_clock
+constexpr auto kCalibrationTime = std::chrono::milliseconds(20);
+
+std::string TimerFromEnvironment() {
+#ifdef _WIN32
+  size_t len;
+  char env_buf[16];
+  if (getenv_s(&len, env_buf, sizeof(env_buf), "PPC_TIMER") == 0 && len != 0) {
+    return env_buf;
+  }
+  return {};
+#else
+  const char *env_ptr = std::getenv("PPC_TIMER");
+  return env_ptr != nullptr ? env_ptr : "";
+#endif
+}
+
+// CPUID.80000007H:EDX[8]: the TSC rate does not change with P-, C- and T-states
+bool HasInvariantTsc() {
+#ifdef PPC_TIMER_TSC
+#ifdef _MSC_VER
+  int regs[4] = {};
+  __cpuid(regs, static_cast<int>(0x80000000));
+  if (static_cast<unsigned>(regs[0]) < 0x80000007U) {
+    return false;
+  }
+  __cpuid(regs, static_cast<int>(0x80000007));
+  return (regs[3] & (1 << 8)) != 0;
+#else
+  unsigned eax = 0;
+  unsigned ebx = 0;
+  unsigned ecx = 0;
+  unsigned edx = 0;
+  return __get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx) != 0 && (edx & (1U << 8)) != 0;
+#endif
+#else
+  return false;
+#endif
+}
+
+struct ClockSample {
+  uint64_t steady_ns;
+  uint64_t tsc;
+};
+
+// steady_clock with the TSC read closest around it: the best of a few tries
+ClockSample Sample() {
+  ClockSample best{.steady_ns = 0, .tsc = 0};
+  uint64_t best_window = UINT64_MAX;
+  for (int i = 0; i < 5; i++) {
+    const uint64_t before = ppc::util::detail::ReadTsc();
+    const uint64_t steady_ns = ppc::util::detail::ReadSteadyNs();
+    const uint64_t after = ppc::util::detail::ReadTsc();
+    if (after - before < best_window) {
+      best_window = after - before;
+      best = {.steady_ns = steady_ns, .tsc = before + ((after - before) / 2)};
+    }
+  }
+  return best;
+}
+
+}  // namespace
+
+ppc::util::TimerCalibration ppc::util::CalibrateTimer() {
+  const std::string requested = TimerFromEnvironment();
+  if (!requested.empty() && requested != "tsc" && requested != "steady") {
+    throw std::invalid_argument("PPC_TIMER='" + requested + "' is not one of tsc, steady");
+  }
+
+  TimerCalibration calibration;
+  if (requested != "steady" && HasInvariantTsc()) {
+    const auto calibration_ns = static_cast<uint64_t>(std::chrono::nanoseconds(kCalibrationTime).count());
+    const ClockSample begin = Sample();
+    ClockSample end = Sample();
+    while (end.steady_ns - begin.steady_ns < calibration_ns) {
+      end = Sample();
+    }
+    calibration.source = TimerSource::kTsc;
+    calibration.seconds_per_tick =
+        static_cast<double>(end.steady_ns - begin.steady_ns) * 1e-9 / static_cast<double>(end.tsc - begin.tsc);
+    calibration.epoch_ticks = detail::ReadTsc();
+  } else {
+    calibration.epoch_ticks = detail::ReadSteadyNs();
+  }
+  return calibration;
+}
+
+std::string ppc::util::TimerSourceName(TimerSource source) { return source == TimerSource::kTsc ? "tsc" : "steady"; }
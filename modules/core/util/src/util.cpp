@@ -7,26 +7,165 @@
 #include <memory>
 #include <vector>
 #endif
+#ifdef __linux__
+#include <sched.h>
+#endif
 
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
 #include <filesystem>
+#include <fstream>
+#include <optional>
+#include <stdexcept>
 #include <string>
+#include <system_error>
+#include <thread>
 
 std::string ppc::util::GetAbsolutePath(const std::string &relative_path) {
   const std::filesystem::path path = std::string(PPC_PATH_TO_PROJECT) + "/tasks/" + relative_path;
   return path.string();
 }
 
-int ppc::util::GetPPCNumThreads() {
+namespace {
+
+std::optional<std::string> GetEnv(const char *name) {
 #ifdef _WIN32
   size_t len;
-  char omp_env[100];
-  errno_t err = getenv_s(&len, omp_env, sizeof(omp_env), "OMP_NUM_THREADS");
+  char value[100];
+  errno_t err = getenv_s(&len, value, sizeof(value), name);
   if (err != 0 || len == 0) {
-    omp_env[0] = '\0';
+    return std::nullopt;
   }
+  return std::string(value);
 #else
-  const char *omp_env = std::getenv("OMP_NUM_THREADS");
+  const char *value = std::getenv(name);
+  if (value == nullptr) {
+    return std::nullopt;
+  }
+  return std::string(value);
 #endif
-  int num_threads = (omp_env != nullptr) ? std::atoi(omp_env) : 1;
+}
+
+// Positive decimal number of threads; OMP_NUM_THREADS may be a list of nested
+// levels ("4,2"), the first entry is the outer level
+int ParseThreadCount(const std::string &name, const std::string &value) {
+  const std::string first = value.substr(0, value.find(','));
+  const auto begin = first.find_first_not_of(" \t");
+  const auto end = first.find_last_not_of(" \t");
+  const std::string digits = begin == std::string::npos ? "" : first.substr(begin, end - begin + 1);
+  const bool is_number =
+      !digits.empty() && digits.size() <= 9 && std::ranges::all_of(digits, [](char c) { return c >= '0' && c <= '9'; });
+  const int num_threads = is_number ? std::stoi(digits) : 0;
+  if (num_threads <= 0) {
+    throw std::invalid_argument(name + "='" + value + "' is not a positive number of threads");
+  }
   return num_threads;
 }
+
+int AffinityCpuCount() {
+#ifdef __linux__
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+    return CPU_COUNT(&set);
+  }
+#endif
+  return static_cast<int>(std::thread::hardware_concurrency());
+}
+
+}  // namespace
+
+// The smallest cgroup v2 "cpu.max" quota on the path from the cgroup of the
+// process to the root, rounded up to whole CPUs (0 - no quota)
+int ppc::util::GetCgroupCpuLimit() {
+  std::ifstream cgroup_file("/proc/self/cgroup");
+  std::string line;
+  std::string cgroup;
+  while (std::getline(cgroup_file, line)) {
+    // v2 unified hierarchy: "0::/path"
+    if (line.rfind("0::", 0) == 0) {
+      cgroup = line.substr(3);
+    }
+  }
+  if (cgroup.empty()) {
+    return 0;
+  }
+
+  int limit = 0;
+  std::filesystem::path path = std::filesystem::path("/sys/fs/cgroup") / std::filesystem::path(cgroup).relative_path();
+  while (true) {
+    std::string quota;
+    double period = 0.0;
+    std::ifstream(path / "cpu.max") >> quota >> period;
+    if (!quota.empty() && quota != "max" && period > 0.0) {
+      const int cpus = std::max(1, static_cast<int>(std::ceil(std::stod(quota) / period)));
+      limit = limit == 0 ? cpus : std::min(limit, cpus);
+    }
+    if (path == "/sys/fs/cgroup" || !path.has_parent_path()) {
+      break;
+    }
+    path = path.parent_path();
+  }
+  return limit;
+}
+
+int ppc::util::GetUsableCpuCount() {
+  int cpus = std::max(1, AffinityCpuCount());
+  const int cgroup_limit = GetCgroupCpuLimit();
+  if (cgroup_limit > 0) {
+    cpus = std::min(cpus, cgroup_limit);
+  }
+  return cpus;
+}
+
+int ppc::util::GetPPCNumThreads() {
+  for (const char *name : {"PPC_NUM_THREADS", "OMP_NUM_THREADS"}) {
+    const auto value = GetEnv(name);
+    if (value.has_value() && !value->empty()) {
+      return ParseThreadCount(name, *value);
+    }
+  }
+  return GetUsableCpuCount();
+}
+
+size_t ppc::util::GetCacheSize(int level) {
+  // Linux exposes cache topology of every CPU in sysfs: index*/{level,type,size}
+  const std::filesystem::path cache_dir("/sys/devices/system/cpu/cpu0/cache");
+  std::error_code ec;
+  if (!std::filesystem::is_directory(cache_dir, ec)) {
+    return 0;
+  }
+  for (const auto &entry : std::filesystem::directory_iterator(cache_dir, ec)) {
+    if (entry.path().filename().string().rfind("index", 0) != 0) {
+      continue;
+    }
+    int cache_level = 0;
+    std::string type;
+    std::string size;
+    std::ifstream(entry.path() / "level") >> cache_level;
+    std::ifstream(entry.path() / "type") >> type;
+    std::ifstream(entry.path() / "size") >> size;
+    if (cache_level != level || type == "Instruction" || size.empty()) {
+      continue;
+    }
+    size_t multiplier = 1;
+    if (size.back() == 'K') {
+      multiplier = size_t{1} << 10;
+    } else if (size.back() == 'M') {
+      multiplier = size_t{1} << 20;
+    }
+    return std::stoull(size) * multiplier;
+  }
+  return 0;
+}
+
+size_t ppc::util::GetLastLevelCacheSize() {
+  for (int level = 4; level > 0; level--) {
+    const size_t size = GetCacheSize(level);
+    if (size != 0) {
+      return size;
+    }
+  }
+  return 0;
+}
@@ -41,6 +41,12 @@ class AverageOfVectorElements : public ppc::core::Task {
     return true;
   }
 
+  // one addition per element, every element is read once
+  [[nodiscard]] double GetFlopsPerRun() const override { return static_cast<double>(input_.size()); }
+  [[nodiscard]] double GetBytesPerRun() const override {
+    return static_cast<double>(input_.size()) * sizeof(InType);
+  }
+
  private:
   std::vector<InType> input_;
   OutType average_;
@@ -1,11 +1,11 @@
 #ifndef MODULES_REFERENCE_MAX_OF_VECTOR_ELEMENTS_REF_TASK_HPP_
 #define MODULES_REFERENCE_MAX_OF_VECTOR_ELEMENTS_REF_TASK_HPP_
 
-#include <algorithm>
 #include <memory>
 #include <vector>
 
 #include "core/task/include/task.hpp"
+#include "core/util/include/simd.hpp"
 
 namespace ppc::reference {
 
@@ -37,9 +37,10 @@ class MaxOfVectorElements : public ppc::core::Task {
   }
 
   bool RunImpl() override {
-    auto result = std::max_element(input_.begin(), input_.end());
-    max_ = static_cast<InOutType>(*result);
-    max_index_ = static_cast<IndexType>(std::distance(input_.begin(), result));
+    // the first largest element, as std::max_element
+    const auto result = ppc::util::ArgMax(input_.data(), input_.size());
+    max_ = result.value;
+    max_index_ = static_cast<IndexType>(result.index);
     return true;
   }
 
@@ -49,6 +50,12 @@ class MaxOfVectorElements : public ppc::core::Task {
     return true;
   }
 
+  // one comparison per element, every element is read once
+  [[nodiscard]] double GetFlopsPerRun() const override { return static_cast<double>(input_.size()); }
+  [[nodiscard]] double GetBytesPerRun() const override {
+    return static_cast<double>(input_.size()) * sizeof(InOutType);
+  }
+
  private:
   std::vector<InOutType> input_;
   InOutType max_;
@@ -1,11 +1,12 @@
 #ifndef MODULES_REFERENCE_NUM_OF_ORDERLY_VIOLATIONS_REF_TASK_HPP_
 #define MODULES_REFERENCE_NUM_OF_ORDERLY_VIOLATIONS_REF_TASK_HPP_
 
-#include <algorithm>
+#include <cstddef>
 #include <memory>
 #include <vector>
 
 #include "core/task/include/task.hpp"
+#include "core/util/include/simd.hpp"
 
 namespace ppc::reference {
 
@@ -31,15 +32,19 @@ class NumOfOrderlyViolations : public ppc::core::Task {
   }
 
   bool RunImpl() override {
-    auto rotate_in = input_;
-    int rot_left = 1;
-    rotate(rotate_in.begin(), rotate_in.begin() + rot_left, rotate_in.end());
-
-    auto temp_res = std::vector<bool>(input_.size());
-    std::transform(input_.begin(), input_.end(), rotate_in.begin(), temp_res.begin(),
-                   [](InOutType x, InOutType y) { return x > y; });
-
-    num_ = std::count_if(temp_res.begin(), temp_res.end() - 1, [](InOutType elem) { return elem; });
+    // x[i] > x[i + 1] for a vector of neighbours at a time
+    using Vec = ppc::util::Simd<InOutType>;
+    const InOutType* x = input_.data();
+    const size_t n = input_.size();
+    size_t count = 0;
+    size_t i = 0;
+    for (; i + Vec::kWidth < n; i += Vec::kWidth) {
+      count += (Vec::LoadUnaligned(x + i) > Vec::LoadUnaligned(x + i + 1)).Count();
+    }
+    for (; i + 1 < n; i++) {
+      count += static_cast<size_t>(x[i] > x[i + 1]);
+    }
+    num_ = static_cast<CountType>(count);
     return true;
   }
 
@@ -1,10 +1,13 @@
 #include <gtest/gtest.h>
 
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <vector>
 
+#include "core/perf/include/size_sweep.hpp"
 #include "core/task/include/task.hpp"
+#include "core/util/include/deterministic_reduce.hpp"
 #include "ref/sum_of_vector_elements/include/ref_task.hpp"
 
 TEST(sum_of_vector_elements, check_int32_t) {
@@ -122,3 +125,65 @@ TEST(sum_of_vector_elements, check_float) {
   test_task.PostProcessing();
   EXPECT_NEAR(out[0], static_cast<float>(in.size()), 1e-3F);
 }
+
+TEST(sum_of_vector_elements, check_size_sweep) {
+  // cache-resident sizes, split into bands by the memory level only
+  ppc::core::SizeSweepAttr attr;
+  attr.min_n = 1 << 11;
+  attr.max_n = 1 << 14;
+  attr.factor = 2.0;
+  attr.min_time_sec = 0.005;
+  attr.drop_threshold = 1.0;
+  struct Buffers {
+    std::vector<int32_t> in;
+    std::vector<int32_t> out;
+  };
+  const auto results = ppc::core::MeasureSizeSweep(
+      [](uint64_t n) {
+        auto buffers = std::make_shared<Buffers>(Buffers{.in = std::vector<int32_t>(n, 1), .out = {0}});
+        auto task_data = std::make_shared<ppc::core::TaskData>();
+        task_data->inputs.emplace_back(reinterpret_cast<uint8_t*>(buffers->in.data()));
+        task_data->inputs_count.emplace_back(buffers->in.size());
+        task_data->outputs.emplace_back(reinterpret_cast<uint8_t*>(buffers->out.data()));
+        task_data->outputs_count.emplace_back(buffers->out.size());
+        return ppc::core::SizedTask{
+            .task = std::make_shared<ppc::reference::SumOfVectorElements<int32_t>>(task_data), .storage = buffers};
+      },
+      attr);
+  ASSERT_EQ(results.points.size(), 4U);
+  for (const auto& point : results.points) {
+    EXPECT_GT(point.throughput, 0.0);
+  }
+  // the kernel is O(n): every band fitted over several sizes has an exponent close to 1
+  size_t fitted_bands = 0;
+  for (const auto& band : results.bands) {
+    if (band.last > band.first) {
+      EXPECT_NEAR(band.k, 1.0, 0.3) << "sizes " << results.points[band.first].n << ".." << results.points[band.last].n;
+      fitted_bands++;
+    }
+  }
+  EXPECT_GE(fitted_bands, 1U);
+}
+
+TEST(sum_of_vector_elements, check_float_matches_parallel_sum) {
+  // Create data: magnitudes that make the naive result depend on the order
+  std::vector<float> in(100000);
+  for (size_t i = 0; i < in.size(); i++) {
+    in[i] = (i % 3 == 0) ? 1.0e7F : 0.1F * static_cast<float>(i % 17);
+  }
+  std::vector<float> out(1, 0);
+  // Create task_data
+  auto task_data = std::make_shared<ppc::core::TaskData>();
+  task_data->inputs.emplace_back(reinterpret_cast<uint8_t*>(in.data()));
+  task_data->inputs_count.emplace_back(in.size());
+  task_data->outputs.emplace_back(reinterpret_cast<uint8_t*>(out.data()));
+  task_data->outputs_count.emplace_back(out.size());
+  // Create Task
+  ppc::reference::SumOfVectorElements<float> test_task(task_data);
+  ASSERT_TRUE(test_task.Validation());
+  test_task.PreProcessing();
+  test_task.Run();
+  test_task.PostProcessing();
+  // a parallel implementation gets the same bits
+  ASSERT_EQ(out[0], ppc::util::DeterministicSum<ppc::util::policy::StdThread>(in));
+}
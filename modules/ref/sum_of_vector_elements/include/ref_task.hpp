@@ -2,9 +2,11 @@
 
 #include <memory>
 #include <numeric>
+#include <type_traits>
 #include <vector>
 
 #include "core/task/include/task.hpp"
+#include "core/util/include/deterministic_reduce.hpp"
 
 namespace ppc::reference {
 
@@ -30,7 +32,12 @@ class SumOfVectorElements : public ppc::core::Task {
   }
 
   bool RunImpl() override {
-    sum_ = std::accumulate(input_.begin(), input_.end(), 0);
+    if constexpr (std::is_floating_point_v<InOutType>) {
+      // fixed summation order, parallel versions can reproduce it bitwise
+      sum_ = ppc::util::DeterministicSum<ppc::util::policy::Seq>(input_);
+    } else {
+      sum_ = std::accumulate(input_.begin(), input_.end(), 0);
+    }
     return true;
   }
 
@@ -39,6 +46,12 @@ class SumOfVectorElements : public ppc::core::Task {
     return true;
   }
 
+  // one addition per element, every element is read once
+  [[nodiscard]] double GetFlopsPerRun() const override { return static_cast<double>(input_.size()); }
+  [[nodiscard]] double GetBytesPerRun() const override {
+    return static_cast<double>(input_.size()) * sizeof(InOutType);
+  }
+
  private:
   std::vector<InOutType> input_;
   InOutType sum_;
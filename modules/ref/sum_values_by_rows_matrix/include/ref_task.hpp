@@ -49,6 +49,12 @@ class SumValuesByRowsMatrix : public ppc::core::Task {
     return true;
   }
 
+  // one addition per element, every element is read once
+  [[nodiscard]] double GetFlopsPerRun() const override { return static_cast<double>(input_.size()); }
+  [[nodiscard]] double GetBytesPerRun() const override {
+    return static_cast<double>(input_.size()) * sizeof(InOutType);
+  }
+
  private:
   std::vector<InOutType> input_;
   IndexType rows_, cols_;
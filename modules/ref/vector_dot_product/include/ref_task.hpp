@@ -4,9 +4,11 @@
 #include <cstddef>
 #include <memory>
 #include <numeric>
+#include <type_traits>
 #include <vector>
 
 #include "core/task/include/task.hpp"
+#include "core/util/include/deterministic_reduce.hpp"
 
 namespace ppc::reference {
 
@@ -36,7 +38,12 @@ class VectorDotProduct : public ppc::core::Task {
   }
 
   bool RunImpl() override {
-    dor_product_ = std::inner_product(input_[0].begin(), input_[0].end(), input_[1].begin(), 0.0);
+    if constexpr (std::is_floating_point_v<InOutType>) {
+      // fixed summation order, parallel versions can reproduce it bitwise
+      dor_product_ = ppc::util::DeterministicDot<ppc::util::policy::Seq>(input_[0], input_[1]);
+    } else {
+      dor_product_ = std::inner_product(input_[0].begin(), input_[0].end(), input_[1].begin(), 0.0);
+    }
     return true;
   }
 
@@ -45,6 +52,14 @@ class VectorDotProduct : public ppc::core::Task {
     return true;
   }
 
+  // one multiply-add per pair of elements, every element is read once
+  [[nodiscard]] double GetFlopsPerRun() const override {
+    return input_.empty() ? 0.0 : static_cast<double>(2 * input_[0].size());
+  }
+  [[nodiscard]] double GetBytesPerRun() const override {
+    return input_.empty() ? 0.0 : static_cast<double>(2 * input_[0].size()) * sizeof(InOutType);
+  }
+
  private:
   std::vector<std::vector<InOutType> > input_;
   InOutType dor_product_;
@@ -2,3 +2,4 @@
 mkdir build\perf_stat_dir
 python3 scripts/run_tests.py --running-type="performance" > build\perf_stat_dir\perf_log.txt
 python scripts\create_perf_table.py --input build\perf_stat_dir\perf_log.txt --output build\perf_stat_dir
+python scripts\perf_baseline.py --input build\perf_stat_dir\perf_log.txt --db build\perf_stat_dir\perf_baselines.sqlite
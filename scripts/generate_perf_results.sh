@@ -1,3 +1,4 @@
 mkdir -p build/perf_stat_dir
 python3 scripts/run_tests.py --running-type="performance" | tee build/perf_stat_dir/perf_log.txt
 python3 scripts/create_perf_table.py --input build/perf_stat_dir/perf_log.txt --output build/perf_stat_dir
+python3 scripts/perf_baseline.py --input build/perf_stat_dir/perf_log.txt --db build/perf_stat_dir/perf_baselines.sqlite
@@ -0,0 +1,130 @@
+import argparse
+import math
+import os
+import re
+import socket
+import sqlite3
+import statistics
+import subprocess
+import sys
+from datetime import datetime, timezone
+
+parser = argparse.ArgumentParser(
+    description='Store per-run perf samples and compare them against the stored baselines')
+parser.add_argument('-i', '--input', help='Input file path (logs of perf tests, .txt)', required=True)
+parser.add_argument('--db', help='SQLite file with the stored runs',
+                    default=os.path.join('build', 'perf_stat_dir', 'perf_baselines.sqlite'))
+parser.add_argument('--host', help='Host name of the key (default: this host)', default=socket.gethostname())
+parser.add_argument('--threshold', type=float, default=0.05,
+                    help='Relative slowdown of the median that counts as a regression')
+parser.add_argument('--alpha', type=float, default=0.01, help='Significance level of the rank-sum test')
+parser.add_argument('--history', type=int, default=3, help='Number of latest accepted runs pooled as baseline')
+parser.add_argument('--fail-on-regression', action='store_true', help='Exit with code 1 if any key regressed')
+parser.add_argument('--dry-run', action='store_true', help='Compare only, do not store the new runs')
+args = parser.parse_args()
+
+# emitted by ppc::core::Perf::PrintPerfStatistic
+samples_pattern = (r'tasks[\/|\\](\w*)[\/|\\](\w*):(\w*):samples:'
+                   r'size=(\d+) threads=(\d+) procs=(\d+) runs=([-+.\deE,]+)')
+key_columns = ['task', 'backend', 'type', 'size', 'threads', 'procs', 'host']
+
+
+def get_revision():
+    try:
+        result = subprocess.run(['git', 'rev-parse', '--short', 'HEAD'], stdout=subprocess.PIPE,
+                                stderr=subprocess.DEVNULL, text=True)
+        return result.stdout.strip() if result.returncode == 0 else ''
+    except OSError:
+        return ''
+
+
+def rank_sum_p_value(baseline, new):
+    """One-sided Mann-Whitney U test that `new` tends to be larger than `baseline`
+    (normal approximation with tie correction)."""
+    n1 = len(baseline)
+    n2 = len(new)
+    values = sorted([(v, 0) for v in baseline] + [(v, 1) for v in new])
+    ranks = [0.0] * len(values)
+    tie_term = 0.0
+    i = 0
+    while i < len(values):
+        j = i
+        while j + 1 < len(values) and values[j + 1][0] == values[i][0]:
+            j += 1
+        for k in range(i, j + 1):
+            ranks[k] = (i + j) / 2.0 + 1.0
+        tie_term += (j - i + 1) ** 3 - (j - i + 1)
+        i = j + 1
+    rank_new = sum(r for r, (_, group) in zip(ranks, values) if group == 1)
+    u_new = rank_new - n2 * (n2 + 1) / 2.0
+    n = n1 + n2
+    variance = n1 * n2 / 12.0 * ((n + 1) - tie_term / (n * (n - 1)))
+    if variance <= 0.0:
+        return 1.0
+    z = (u_new - n1 * n2 / 2.0 - 0.5) / math.sqrt(variance)
+    return 0.5 * math.erfc(z / math.sqrt(2.0))
+
+
+def parse_logs(path):
+    runs = []
+    with open(path, 'r') as logs_file:
+        for line in logs_file:
+            result = re.findall(samples_pattern, line)
+            if len(result):
+                backend, task, perf_type, size, threads, procs, samples = result[0]
+                runs.append({'task': task, 'backend': backend, 'type': perf_type, 'size': int(size),
+                             'threads': int(threads), 'procs': int(procs), 'host': args.host,
+                             'samples': [float(v) for v in samples.split(',') if v]})
+    return runs
+
+
+def open_db(path):
+    os.makedirs(os.path.dirname(os.path.abspath(path)), exist_ok=True)
+    connection = sqlite3.connect(path)
+    connection.execute('CREATE TABLE IF NOT EXISTS runs ('
+                       'id INTEGER PRIMARY KEY AUTOINCREMENT, task TEXT, backend TEXT, type TEXT, size INTEGER, '
+                       'threads INTEGER, procs INTEGER, host TEXT, created TEXT, revision TEXT, samples TEXT, '
+                       'regression INTEGER)')
+    return connection
+
+
+def load_baseline(connection, run):
+    where = ' AND '.join(f'{column} = ?' for column in key_columns)
+    rows = connection.execute(f'SELECT samples FROM runs WHERE {where} AND regression = 0 ORDER BY id DESC LIMIT ?',
+                              [run[column] for column in key_columns] + [args.history]).fetchall()
+    return [float(v) for (samples,) in rows for v in samples.split(',')]
+
+
+connection = open_db(args.db)
+revision = get_revision()
+created = datetime.now(timezone.utc).isoformat(timespec='seconds')
+regressions = 0
+for run in parse_logs(os.path.abspath(args.input)):
+    name = (f"{run['backend']}/{run['task']}:{run['type']} size={run['size']} threads={run['threads']} "
+            f"procs={run['procs']}")
+    baseline = load_baseline(connection, run)
+    regression = False
+    if not baseline:
+        print(f'{name}: no baseline, median={statistics.median(run["samples"]):.10f}')
+    else:
+        base_median = statistics.median(baseline)
+        new_median = statistics.median(run['samples'])
+        change = new_median / base_median - 1.0 if base_median > 0 else 0.0
+        p_value = rank_sum_p_value(baseline, run['samples'])
+        regression = p_value < args.alpha and change > args.threshold
+        status = 'REGRESSION' if regression else 'ok'
+        print(f'{name}: baseline={base_median:.10f} new={new_median:.10f} change={100.0 * change:+.2f}% '
+              f'p={p_value:.4g} {status}')
+    regressions += int(regression)
+    if not args.dry_run:
+        connection.execute('INSERT INTO runs (task, backend, type, size, threads, procs, host, created, revision, '
+                           'samples, regression) VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)',
+                           [run[column] for column in key_columns] +
+                           [created, revision, ','.join(repr(v) for v in run['samples']), int(regression)])
+connection.commit()
+connection.close()
+
+if regressions:
+    print(f'Warning! {regressions} configuration(s) regressed by more than {100.0 * args.threshold:.1f}%')
+    if args.fail_on_regression:
+        sys.exit(1)
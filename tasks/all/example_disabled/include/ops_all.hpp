@@ -16,6 +16,8 @@ class TestTaskALL : public ppc::core::Task {
   bool ValidationImpl() override;
   bool RunImpl() override;
   bool PostProcessingImpl() override;
+  [[nodiscard]] double GetFlopsPerRun() const override;
+  [[nodiscard]] double GetBytesPerRun() const override;
 
  private:
   std::vector<int> input_, output_;
@@ -2,26 +2,12 @@
 
 #include <cmath>
 #include <cstddef>
-#include <functional>
-#include <thread>
 #include <vector>
 
-#include "core/util/include/util.hpp"
+#include "common/example/include/matmul.hpp"
+#include "core/util/include/parallel.hpp"
+#include "core/util/include/parallel_tbb.hpp"
 #include "oneapi/tbb/task_arena.h"
-#include "oneapi/tbb/task_group.h"
-
-namespace {
-void MatMul(const std::vector<int> &in_vec, int rc_size, std::vector<int> &out_vec) {
-  for (int i = 0; i < rc_size; ++i) {
-    for (int j = 0; j < rc_size; ++j) {
-      out_vec[(i * rc_size) + j] = 0;
-      for (int k = 0; k < rc_size; ++k) {
-        out_vec[(i * rc_size) + j] += in_vec[(i * rc_size) + k] * in_vec[(k * rc_size) + j];
-      }
-    }
-  }
-}
-}  // namespace
 
 bool nesterov_a_test_task_all::TestTaskALL::PreProcessingImpl() {
   // Init value for input and output
@@ -42,29 +28,15 @@ bool nesterov_a_test_task_all::TestTaskALL::ValidationImpl() {
 }
 
 bool nesterov_a_test_task_all::TestTaskALL::RunImpl() {
+  // one kernel body, instantiated for the backend of every stage
   if (world_.rank() == 0) {
-#pragma omp parallel default(none)
-    {
-#pragma omp critical
-      { MatMul(input_, rc_size_, output_); }
-    }
+    nesterov_a_test_task::MatMul<ppc::util::policy::OpenMP>(input_, rc_size_, output_, "omp");
   } else {
     oneapi::tbb::task_arena arena(1);
-    arena.execute([&] {
-      tbb::task_group tg;
-      for (int i = 0; i < ppc::util::GetPPCNumThreads(); ++i) {
-        tg.run([&] { MatMul(input_, rc_size_, output_); });
-      }
-      tg.wait();
-    });
-  }
-
-  const int num_threads = ppc::util::GetPPCNumThreads();
-  std::vector<std::thread> threads(num_threads);
-  for (int i = 0; i < num_threads; i++) {
-    threads[i] = std::thread(MatMul, std::cref(input_), rc_size_, std::ref(output_));
-    threads[i].join();
+    arena.execute(
+        [&] { nesterov_a_test_task::MatMul<ppc::util::policy::TBB>(input_, rc_size_, output_, "tbb"); });
   }
+  nesterov_a_test_task::MatMul<ppc::util::policy::StdThread>(input_, rc_size_, output_, "thread");
 
   world_.barrier();
   return true;
@@ -76,3 +48,11 @@ bool nesterov_a_test_task_all::TestTaskALL::PostProcessingImpl() {
   }
   return true;
 }
+
+double nesterov_a_test_task_all::TestTaskALL::GetFlopsPerRun() const {
+  return nesterov_a_test_task::MatMulFlops(rc_size_);
+}
+
+double nesterov_a_test_task_all::TestTaskALL::GetBytesPerRun() const {
+  return nesterov_a_test_task::MatMulBytes(rc_size_);
+}
@@ -1,4 +1,6 @@
 #include <gtest/gtest.h>
+#include <mpi.h>
+#include <omp.h>
 #include <tbb/global_control.h>
 
 #include <boost/mpi/communicator.hpp>
@@ -9,6 +11,11 @@
 #include <string>
 #include <utility>
 
+#include "core/trace/include/trace.hpp"
+#include "core/util/include/affinity.hpp"
+#include "core/util/include/affinity_tbb.hpp"
+#include "core/util/include/node_mpi.hpp"
+#include "core/util/include/thread_pool.hpp"
 #include "core/util/include/util.hpp"
 #include "oneapi/tbb/global_control.h"
 
@@ -64,8 +71,33 @@ int main(int argc, char** argv) {
   boost::mpi::environment env(argc, argv);
   boost::mpi::communicator world;
 
-  // Limit the number of threads in TBB
-  tbb::global_control control(tbb::global_control::max_allowed_parallelism, ppc::util::GetPPCNumThreads());
+  // Tag trace events with the rank of the process
+  ppc::core::Trace::SetProcessId(world.rank());
+
+  // Split the cores of the node between the processes running on it, so that
+  // `mpirun -np 4` on one node does not start four full sets of threads
+  const auto partition = ppc::util::PartitionNode(MPI_COMM_WORLD);
+  const auto affinity = ppc::util::GetAffinityPolicy();
+  if (affinity.kind == ppc::util::AffinityKind::kCompact || affinity.kind == ppc::util::AffinityKind::kScatter) {
+    // disjoint masks: the policy then places the threads within the share
+    ppc::util::RestrictCurrentThread(partition.cpus);
+  }
+
+  // Use the share in TBB, OpenMP and the std::thread pool; tasks asking
+  // GetPPCNumThreads() see the same number
+  const int num_threads = partition.num_threads;
+#ifdef _WIN32
+  _putenv_s("PPC_NUM_THREADS", std::to_string(num_threads).c_str());
+#else
+  setenv("PPC_NUM_THREADS", std::to_string(num_threads).c_str(), 1);  // NOLINT(misc-include-cleaner)
+#endif
+  tbb::global_control control(tbb::global_control::max_allowed_parallelism, num_threads);
+  omp_set_num_threads(num_threads);
+
+  // Place the threads of every backend as PPC_AFFINITY says
+  ppc::util::ApplyAffinityOpenMP(affinity);
+  ppc::util::AffinityObserver tbb_affinity(affinity);
+  ppc::util::ThreadPool::Global().SetAffinity(affinity);
 
   ::testing::InitGoogleTest(&argc, argv);
 
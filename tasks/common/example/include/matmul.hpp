@@ -0,0 +1,52 @@
+#pragma once
+
+#include <vector>
+
+#include "core/trace/include/load_balance.hpp"
+#include "core/trace/include/trace.hpp"
+#include "core/util/include/parallel.hpp"
+
+// Kernel of the example tasks, shared by every backend: the same body is
+// instantiated per policy of parallel.hpp. Include parallel_tbb.hpp before
+// instantiating it for TBB.
+namespace nesterov_a_test_task {
+
+// out = in * in for the rows [row_begin, row_end) of the rc_size x rc_size matrix
+inline void MatMulRows(const std::vector<int> &in_vec, int rc_size, std::vector<int> &out_vec, int row_begin,
+                       int row_end) {
+  for (int i = row_begin; i < row_end; ++i) {
+    for (int j = 0; j < rc_size; ++j) {
+      out_vec[(i * rc_size) + j] = 0;
+      for (int k = 0; k < rc_size; ++k) {
+        out_vec[(i * rc_size) + j] += in_vec[(i * rc_size) + k] * in_vec[(k * rc_size) + j];
+      }
+    }
+  }
+}
+
+// Work of one product, the roofline counts of every backend
+inline double MatMulFlops(int rc_size) {
+  // one multiply-add per (i, j, k)
+  const auto n = static_cast<double>(rc_size);
+  return 2.0 * n * n * n;
+}
+
+inline double MatMulBytes(int rc_size) {
+  // the input matrix is read and the result is written at least once
+  const auto n = static_cast<double>(rc_size);
+  return 2.0 * n * n * sizeof(int);
+}
+
+// The whole product with the rows split over the workers of `Policy`, traced
+// under `category` and accounted as one parallel region
+template <typename Policy>
+void MatMul(const std::vector<int> &in_vec, int rc_size, std::vector<int> &out_vec, const char *category) {
+  ppc::core::TraceSpan span("matmul", category);
+  ppc::core::ParallelRegion region("matmul", ppc::util::NumWorkers<Policy>());
+  ppc::util::ParallelFor<Policy>(0, rc_size, [&](int row) {
+    ppc::core::WorkerScope scope(region, ppc::util::WorkerIndex<Policy>(), rc_size);
+    MatMulRows(in_vec, rc_size, out_vec, row, row + 1);
+  });
+}
+
+}  // namespace nesterov_a_test_task
@@ -16,6 +16,9 @@ class TestTaskMPI : public ppc::core::Task {
   bool ValidationImpl() override;
   bool RunImpl() override;
   bool PostProcessingImpl() override;
+  [[nodiscard]] double GetFlopsPerRun() const override;
+  [[nodiscard]] double GetBytesPerRun() const override;
+  void ResetRunState() override;
 
  private:
   std::vector<int> input_, output_;
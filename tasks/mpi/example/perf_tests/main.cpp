@@ -1,6 +1,5 @@
 #include <gtest/gtest.h>
 
-#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
@@ -8,6 +7,7 @@
 
 #include "boost/mpi/communicator.hpp"
 #include "core/perf/include/perf.hpp"
+#include "core/perf/include/perf_mpi.hpp"
 #include "core/task/include/task.hpp"
 #include "mpi/example/include/ops_mpi.hpp"
 
@@ -35,22 +35,21 @@ TEST(nesterov_a_test_task_mpi, test_pipeline_run) {
   // Create Perf attributes
   auto perf_attr = std::make_shared<ppc::core::PerfAttr>();
   perf_attr->num_running = 10;
-  const auto t0 = std::chrono::high_resolution_clock::now();
-  perf_attr->current_timer = [&] {
-    auto current_time_point = std::chrono::high_resolution_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(current_time_point - t0).count();
-    return static_cast<double>(duration) * 1e-9;
-  };
+  ppc::core::SetMpiPerfAttr(*perf_attr);
 
   // Create and init perf results
   auto perf_results = std::make_shared<ppc::core::PerfResults>();
 
   auto perf_analyzer = std::make_shared<ppc::core::Perf>(test_task_mpi);
   perf_analyzer->PipelineRun(perf_attr, perf_results);
-  // Create Perf analyzer
+
+  // Reduce per-process times, the slowest process defines the time of every run
+  auto mpi_results = ppc::core::ReduceMpiPerfResults(*perf_results);
   boost::mpi::communicator world;
   if (world.rank() == 0) {
+    ppc::core::SetMpiPerfResults(*perf_results, mpi_results);
     ppc::core::Perf::PrintPerfStatistic(perf_results);
+    ppc::core::PrintMpiPerfStatistic(mpi_results);
   }
 
   ASSERT_EQ(in, out);
@@ -80,12 +79,10 @@ TEST(nesterov_a_test_task_mpi, test_task_run) {
   // Create Perf attributes
   auto perf_attr = std::make_shared<ppc::core::PerfAttr>();
   perf_attr->num_running = 10;
-  const auto t0 = std::chrono::high_resolution_clock::now();
-  perf_attr->current_timer = [&] {
-    auto current_time_point = std::chrono::high_resolution_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(current_time_point - t0).count();
-    return static_cast<double>(duration) * 1e-9;
-  };
+  // check that repeated Run() calls compute on reset state
+  perf_attr->verify_runs = true;
+  perf_attr->output_bytes = {out.size() * sizeof(int)};
+  ppc::core::SetMpiPerfAttr(*perf_attr);
 
   // Create and init perf results
   auto perf_results = std::make_shared<ppc::core::PerfResults>();
@@ -93,10 +90,14 @@ TEST(nesterov_a_test_task_mpi, test_task_run) {
   // Create Perf analyzer
   auto perf_analyzer = std::make_shared<ppc::core::Perf>(test_task_mpi);
   perf_analyzer->TaskRun(perf_attr, perf_results);
-  // Create Perf analyzer
+
+  // Reduce per-process times, the slowest process defines the time of every run
+  auto mpi_results = ppc::core::ReduceMpiPerfResults(*perf_results);
   boost::mpi::communicator world;
   if (world.rank() == 0) {
+    ppc::core::SetMpiPerfResults(*perf_results, mpi_results);
     ppc::core::Perf::PrintPerfStatistic(perf_results);
+    ppc::core::PrintMpiPerfStatistic(mpi_results);
   }
 
   ASSERT_EQ(in, out);
@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+#include <mpi.h>
+
+#include <cstdint>
+#include <functional>
+#include <string>
+
+#include "core/perf/include/overhead.hpp"
+
+namespace {
+
+// The number of processes is fixed by mpirun: measure with one thread per
+// process and put the process count into the operation name
+ppc::core::OverheadAttr MpiOverheadAttr() {
+  ppc::core::OverheadAttr attr;
+  attr.max_threads = 1;
+  return attr;
+}
+
+std::string OperationName(const std::string &operation) {
+  int size = 1;
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  return operation + "_np" + std::to_string(size);
+}
+
+bool IsRoot() {
+  int rank = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  return rank == 0;
+}
+
+}  // namespace
+
+TEST(nesterov_a_test_task_mpi, test_overhead_barrier) {
+  auto factory = [](int) -> std::function<void()> { return [] { MPI_Barrier(MPI_COMM_WORLD); }; };
+
+  const auto points = ppc::core::MeasureOverhead(factory, MpiOverheadAttr());
+  if (IsRoot()) {
+    ppc::core::PrintOverhead("mpi/example", OperationName("barrier"), points);
+  }
+
+  ASSERT_FALSE(points.empty());
+}
+
+TEST(nesterov_a_test_task_mpi, test_overhead_bcast_8_bytes) {
+  uint64_t value = 0;
+  auto factory = [&value](int) -> std::function<void()> {
+    return [&value] { MPI_Bcast(&value, sizeof(value), MPI_BYTE, 0, MPI_COMM_WORLD); };
+  };
+
+  const auto points = ppc::core::MeasureOverhead(factory, MpiOverheadAttr());
+  if (IsRoot()) {
+    ppc::core::PrintOverhead("mpi/example", OperationName("bcast_8b"), points);
+  }
+
+  ASSERT_FALSE(points.empty());
+}
@@ -1,9 +1,13 @@
 #include "mpi/example/include/ops_mpi.hpp"
 
+#include <algorithm>
 #include <cmath>
 #include <cstddef>
 #include <vector>
 
+#include "common/example/include/matmul.hpp"
+#include "core/trace/include/trace.hpp"
+
 bool nesterov_a_test_task_mpi::TestTaskMPI::PreProcessingImpl() {
   // Init value for input and output
   unsigned int input_size = task_data->inputs_count[0];
@@ -23,32 +27,51 @@ bool nesterov_a_test_task_mpi::TestTaskMPI::ValidationImpl() {
 }
 
 bool nesterov_a_test_task_mpi::TestTaskMPI::RunImpl() {
-  if (world_.rank() == 0) {
-    // Multiply matrices
-    for (int i = 0; i < rc_size_; ++i) {
-      for (int j = 0; j < rc_size_; ++j) {
-        for (int k = 0; k < rc_size_; ++k) {
-          output_[(i * rc_size_) + j] += input_[(i * rc_size_) + k] * input_[(k * rc_size_) + j];
+  {
+    ppc::core::TraceSpan span("compute", "rank");
+    if (world_.rank() == 0) {
+      // Multiply matrices
+      for (int i = 0; i < rc_size_; ++i) {
+        for (int j = 0; j < rc_size_; ++j) {
+          for (int k = 0; k < rc_size_; ++k) {
+            output_[(i * rc_size_) + j] += input_[(i * rc_size_) + k] * input_[(k * rc_size_) + j];
+          }
         }
       }
-    }
-  } else {
-    // Multiply matrices
-    for (int j = 0; j < rc_size_; ++j) {
-      for (int k = 0; k < rc_size_; ++k) {
-        for (int i = 0; i < rc_size_; ++i) {
-          output_[(i * rc_size_) + j] += input_[(i * rc_size_) + k] * input_[(k * rc_size_) + j];
+    } else {
+      // Multiply matrices
+      for (int j = 0; j < rc_size_; ++j) {
+        for (int k = 0; k < rc_size_; ++k) {
+          for (int i = 0; i < rc_size_; ++i) {
+            output_[(i * rc_size_) + j] += input_[(i * rc_size_) + k] * input_[(k * rc_size_) + j];
+          }
         }
       }
     }
   }
-  world_.barrier();
+  {
+    ppc::core::TraceSpan span("barrier", "rank");
+    world_.barrier();
+  }
   return true;
 }
 
+void nesterov_a_test_task_mpi::TestTaskMPI::ResetRunState() {
+  // RunImpl() accumulates the products into output_
+  std::ranges::fill(output_, 0);
+}
+
 bool nesterov_a_test_task_mpi::TestTaskMPI::PostProcessingImpl() {
   for (size_t i = 0; i < output_.size(); i++) {
     reinterpret_cast<int *>(task_data->outputs[0])[i] = output_[i];
   }
   return true;
 }
+
+double nesterov_a_test_task_mpi::TestTaskMPI::GetFlopsPerRun() const {
+  return nesterov_a_test_task::MatMulFlops(rc_size_);
+}
+
+double nesterov_a_test_task_mpi::TestTaskMPI::GetBytesPerRun() const {
+  return nesterov_a_test_task::MatMulBytes(rc_size_);
+}
@@ -8,6 +8,8 @@
 #include <string>
 #include <utility>
 
+#include "core/trace/include/trace.hpp"
+
 class UnreadMessagesDetector : public ::testing::EmptyTestEventListener {
  public:
   UnreadMessagesDetector(boost::mpi::communicator com) : com_(std::move(com)) {}
@@ -60,6 +62,9 @@ int main(int argc, char** argv) {
   boost::mpi::environment env(argc, argv);
   boost::mpi::communicator world;
 
+  // Tag trace events with the rank of the process
+  ppc::core::Trace::SetProcessId(world.rank());
+
   ::testing::InitGoogleTest(&argc, argv);
 
   auto& listeners = ::testing::UnitTest::GetInstance()->listeners();
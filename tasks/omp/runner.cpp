@@ -1,6 +1,15 @@
 #include <gtest/gtest.h>
+#include <omp.h>
+
+#include "core/util/include/affinity.hpp"
+#include "core/util/include/util.hpp"
 
 int main(int argc, char **argv) {
+  // Use the same number of threads as TBB and std::thread tasks
+  omp_set_num_threads(ppc::util::GetPPCNumThreads());
+  // Place the team as PPC_AFFINITY says
+  ppc::util::ApplyAffinityOpenMP(ppc::util::GetAffinityPolicy());
+
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
 }
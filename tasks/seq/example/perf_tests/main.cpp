@@ -1,12 +1,13 @@
 #include <gtest/gtest.h>
 
-#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <vector>
 
 #include "core/perf/include/perf.hpp"
+#include "core/perf/include/size_sweep.hpp"
+#include "core/perf/include/throughput.hpp"
 #include "core/task/include/task.hpp"
 #include "seq/example/include/ops_seq.hpp"
 
@@ -34,12 +35,6 @@ TEST(nesterov_a_test_task_seq, test_pipeline_run) {
   // Create Perf attributes
   auto perf_attr = std::make_shared<ppc::core::PerfAttr>();
   perf_attr->num_running = 10;
-  const auto t0 = std::chrono::high_resolution_clock::now();
-  perf_attr->current_timer = [&] {
-    auto current_time_point = std::chrono::high_resolution_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(current_time_point - t0).count();
-    return static_cast<double>(duration) * 1e-9;
-  };
 
   // Create and init perf results
   auto perf_results = std::make_shared<ppc::core::PerfResults>();
@@ -75,12 +70,9 @@ TEST(nesterov_a_test_task_seq, test_task_run) {
   // Create Perf attributes
   auto perf_attr = std::make_shared<ppc::core::PerfAttr>();
   perf_attr->num_running = 10;
-  const auto t0 = std::chrono::high_resolution_clock::now();
-  perf_attr->current_timer = [&] {
-    auto current_time_point = std::chrono::high_resolution_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(current_time_point - t0).count();
-    return static_cast<double>(duration) * 1e-9;
-  };
+  // check that repeated Run() calls compute on reset state
+  perf_attr->verify_runs = true;
+  perf_attr->output_bytes = {out.size() * sizeof(int)};
 
   // Create and init perf results
   auto perf_results = std::make_shared<ppc::core::PerfResults>();
@@ -91,3 +83,68 @@ TEST(nesterov_a_test_task_seq, test_task_run) {
   ppc::core::Perf::PrintPerfStatistic(perf_results);
   ASSERT_EQ(in, out);
 }
+
+TEST(nesterov_a_test_task_seq, test_throughput) {
+  constexpr int kCount = 200;
+  constexpr int kMaxCopies = 4;
+
+  // Create data of every copy
+  std::vector<std::vector<int>> in(kMaxCopies, std::vector<int>(kCount * kCount, 0));
+  std::vector<std::vector<int>> out(kMaxCopies, std::vector<int>(kCount * kCount, 0));
+
+  for (auto &copy_in : in) {
+    for (size_t i = 0; i < kCount; i++) {
+      copy_in[(i * kCount) + i] = 1;
+    }
+  }
+
+  // Create independent tasks with their own task_data
+  auto factory = [&](int copy) {
+    auto task_data_seq = std::make_shared<ppc::core::TaskData>();
+    task_data_seq->inputs.emplace_back(reinterpret_cast<uint8_t *>(in[copy].data()));
+    task_data_seq->inputs_count.emplace_back(in[copy].size());
+    task_data_seq->outputs.emplace_back(reinterpret_cast<uint8_t *>(out[copy].data()));
+    task_data_seq->outputs_count.emplace_back(out[copy].size());
+    return std::make_shared<nesterov_a_test_task_seq::TestTaskSequential>(task_data_seq);
+  };
+
+  ppc::core::ThroughputAttr throughput_attr;
+  throughput_attr.runs_per_copy = 5;
+  throughput_attr.max_concurrency = kMaxCopies;
+  const auto points = ppc::core::MeasureThroughput(factory, throughput_attr);
+  ppc::core::PrintThroughput("seq/example", points);
+  ASSERT_EQ(in, out);
+}
+
+TEST(nesterov_a_test_task_seq, test_size_sweep) {
+  // Identity matrix of n x n elements
+  ppc::core::RegisterInputGenerator("nesterov_a_test_task_seq", [](uint64_t n) {
+    struct Storage {
+      std::vector<int> in;
+      std::vector<int> out;
+    };
+    auto storage = std::make_shared<Storage>();
+    storage->in.assign(n * n, 0);
+    storage->out.assign(n * n, 0);
+    for (size_t i = 0; i < n; i++) {
+      storage->in[(i * n) + i] = 1;
+    }
+
+    auto task_data_seq = std::make_shared<ppc::core::TaskData>();
+    task_data_seq->inputs.emplace_back(reinterpret_cast<uint8_t *>(storage->in.data()));
+    task_data_seq->inputs_count.emplace_back(storage->in.size());
+    task_data_seq->outputs.emplace_back(reinterpret_cast<uint8_t *>(storage->out.data()));
+    task_data_seq->outputs_count.emplace_back(storage->out.size());
+    return ppc::core::SizedTask{.task = std::make_shared<nesterov_a_test_task_seq::TestTaskSequential>(task_data_seq),
+                                .storage = storage};
+  });
+
+  ppc::core::SizeSweepAttr sweep_attr;
+  sweep_attr.min_n = 16;
+  sweep_attr.max_n = 256;
+  sweep_attr.min_time_sec = 0.02;
+  const auto &generator = ppc::core::GetInputGenerator("nesterov_a_test_task_seq");
+  const auto results = ppc::core::MeasureSizeSweep(generator, sweep_attr);
+  ppc::core::PrintSizeSweep("seq/example", results);
+  ASSERT_EQ(results.points.size(), 5U);
+}
@@ -4,6 +4,9 @@
 #include <cstddef>
 #include <vector>
 
+#include "common/example/include/matmul.hpp"
+#include "core/util/include/parallel.hpp"
+
 bool nesterov_a_test_task_seq::TestTaskSequential::PreProcessingImpl() {
   // Init value for input and output
   unsigned int input_size = task_data->inputs_count[0];
@@ -23,14 +26,7 @@ bool nesterov_a_test_task_seq::TestTaskSequential::ValidationImpl() {
 }
 
 bool nesterov_a_test_task_seq::TestTaskSequential::RunImpl() {
-  // Multiply matrices
-  for (int i = 0; i < rc_size_; ++i) {
-    for (int j = 0; j < rc_size_; ++j) {
-      for (int k = 0; k < rc_size_; ++k) {
-        output_[(i * rc_size_) + j] += input_[(i * rc_size_) + k] * input_[(k * rc_size_) + j];
-      }
-    }
-  }
+  nesterov_a_test_task::MatMul<ppc::util::policy::Seq>(input_, rc_size_, output_, "seq");
   return true;
 }
 
@@ -40,3 +36,11 @@ bool nesterov_a_test_task_seq::TestTaskSequential::PostProcessingImpl() {
   }
   return true;
 }
+
+double nesterov_a_test_task_seq::TestTaskSequential::GetFlopsPerRun() const {
+  return nesterov_a_test_task::MatMulFlops(rc_size_);
+}
+
+double nesterov_a_test_task_seq::TestTaskSequential::GetBytesPerRun() const {
+  return nesterov_a_test_task::MatMulBytes(rc_size_);
+}
@@ -2,23 +2,10 @@
 
 #include <cmath>
 #include <cstddef>
-#include <thread>
 #include <vector>
 
-#include "core/util/include/util.hpp"
-
-namespace {
-void MatMul(const std::vector<int> &in_vec, int rc_size, std::vector<int> &out_vec) {
-  for (int i = 0; i < rc_size; ++i) {
-    for (int j = 0; j < rc_size; ++j) {
-      out_vec[(i * rc_size) + j] = 0;
-      for (int k = 0; k < rc_size; ++k) {
-        out_vec[(i * rc_size) + j] += in_vec[(i * rc_size) + k] * in_vec[(k * rc_size) + j];
-      }
-    }
-  }
-}
-}  // namespace
+#include "common/example/include/matmul.hpp"
+#include "core/util/include/parallel.hpp"
 
 bool nesterov_a_test_task_stl::TestTaskSTL::PreProcessingImpl() {
   // Init value for input and output
@@ -39,12 +26,8 @@ bool nesterov_a_test_task_stl::TestTaskSTL::ValidationImpl() {
 }
 
 bool nesterov_a_test_task_stl::TestTaskSTL::RunImpl() {
-  const int num_threads = ppc::util::GetPPCNumThreads();
-  std::vector<std::thread> threads(num_threads);
-  for (int i = 0; i < num_threads; i++) {
-    threads[i] = std::thread(MatMul, std::cref(input_), rc_size_, std::ref(output_));
-    threads[i].join();
-  }
+  // rows are split over the process-wide pool instead of new threads per run
+  nesterov_a_test_task::MatMul<ppc::util::policy::StdThread>(input_, rc_size_, output_, "thread");
   return true;
 }
 
@@ -54,3 +37,11 @@ bool nesterov_a_test_task_stl::TestTaskSTL::PostProcessingImpl() {
   }
   return true;
 }
+
+double nesterov_a_test_task_stl::TestTaskSTL::GetFlopsPerRun() const {
+  return nesterov_a_test_task::MatMulFlops(rc_size_);
+}
+
+double nesterov_a_test_task_stl::TestTaskSTL::GetBytesPerRun() const {
+  return nesterov_a_test_task::MatMulBytes(rc_size_);
+}
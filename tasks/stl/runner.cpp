@@ -1,6 +1,12 @@
 #include <gtest/gtest.h>
 
+#include "core/util/include/affinity.hpp"
+#include "core/util/include/thread_pool.hpp"
+
 int main(int argc, char **argv) {
+  // Place the threads of the pool as PPC_AFFINITY says
+  ppc::util::ThreadPool::Global().SetAffinity(ppc::util::GetAffinityPolicy());
+
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
 }
@@ -1,27 +1,11 @@
 #include "tbb/example/include/ops_tbb.hpp"
 
-#include <tbb/tbb.h>
-
 #include <cmath>
-#include <core/util/include/util.hpp>
 #include <cstddef>
 #include <vector>
 
-#include "oneapi/tbb/task_arena.h"
-#include "oneapi/tbb/task_group.h"
-
-namespace {
-void MatMul(const std::vector<int> &in_vec, int rc_size, std::vector<int> &out_vec) {
-  for (int i = 0; i < rc_size; ++i) {
-    for (int j = 0; j < rc_size; ++j) {
-      out_vec[(i * rc_size) + j] = 0;
-      for (int k = 0; k < rc_size; ++k) {
-        out_vec[(i * rc_size) + j] += in_vec[(i * rc_size) + k] * in_vec[(k * rc_size) + j];
-      }
-    }
-  }
-}
-}  // namespace
+#include "common/example/include/matmul.hpp"
+#include "core/util/include/parallel_tbb.hpp"
 
 bool nesterov_a_test_task_tbb::TestTaskTBB::PreProcessingImpl() {
   // Init value for input and output
@@ -42,14 +26,7 @@ bool nesterov_a_test_task_tbb::TestTaskTBB::ValidationImpl() {
 }
 
 bool nesterov_a_test_task_tbb::TestTaskTBB::RunImpl() {
-  oneapi::tbb::task_arena arena(1);
-  arena.execute([&] {
-    tbb::task_group tg;
-    for (int thr = 0; thr < ppc::util::GetPPCNumThreads(); ++thr) {
-      tg.run([&] { MatMul(input_, rc_size_, output_); });
-    }
-    tg.wait();
-  });
+  nesterov_a_test_task::MatMul<ppc::util::policy::TBB>(input_, rc_size_, output_, "tbb");
   return true;
 }
 
@@ -59,3 +36,11 @@ bool nesterov_a_test_task_tbb::TestTaskTBB::PostProcessingImpl() {
   }
   return true;
 }
+
+double nesterov_a_test_task_tbb::TestTaskTBB::GetFlopsPerRun() const {
+  return nesterov_a_test_task::MatMulFlops(rc_size_);
+}
+
+double nesterov_a_test_task_tbb::TestTaskTBB::GetBytesPerRun() const {
+  return nesterov_a_test_task::MatMulBytes(rc_size_);
+}